@@ -0,0 +1,112 @@
+// GxEPD2_4G_Example : 4 grey levels on b/w panels with a grey waveform, GxEPD2_290_T94 and GxEPD2_420
+//
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// GxEPD2_4G is used like GxEPD2_BW, with 2 bits per pixel; GxEPD_LIGHTGREY and GxEPD_DARKGREY select the grey levels,
+// other colors are quantized by luminance; the refresh is always a full refresh with the grey waveform
+
+// see GxEPD2_wiring_examples.h of GxEPD2_Example for wiring suggestions and examples
+// if you use a different wiring, you need to adapt the constructor parameters!
+
+// uncomment next line to use class GFX of library GFX_Root instead of Adafruit_GFX
+//#include <GFX.h>
+
+#include <GxEPD2_4G.h>
+#include <Fonts/FreeMonoBold9pt7b.h>
+
+// select one driver class, these have writeImage_4G()
+#define GxEPD2_DRIVER_CLASS GxEPD2_290_T94 // GDEM029T94 128x296
+//#define GxEPD2_DRIVER_CLASS GxEPD2_420     // GDEW042T2 400x300
+
+// 4 pixels per byte
+#if defined(ESP8266) || defined(ESP32)
+#define MAX_DISPLAY_BUFFER_SIZE 32768ul // full height for both panels
+#elif defined(__AVR)
+#define MAX_DISPLAY_BUFFER_SIZE 800 // e.g. 25 rows of 128 pixels
+#else
+#define MAX_DISPLAY_BUFFER_SIZE 15000ul // ~15k is a good compromise
+#endif
+#define MAX_HEIGHT(EPD) (EPD::HEIGHT <= MAX_DISPLAY_BUFFER_SIZE / (EPD::WIDTH / 4) ? EPD::HEIGHT : MAX_DISPLAY_BUFFER_SIZE / (EPD::WIDTH / 4))
+
+#if defined(ESP32)
+GxEPD2_4G<GxEPD2_DRIVER_CLASS, MAX_HEIGHT(GxEPD2_DRIVER_CLASS)> display(GxEPD2_DRIVER_CLASS(/*CS=5*/ SS, /*DC=*/ 17, /*RST=*/ 16, /*BUSY=*/ 4));
+#elif defined(ESP8266)
+GxEPD2_4G<GxEPD2_DRIVER_CLASS, MAX_HEIGHT(GxEPD2_DRIVER_CLASS)> display(GxEPD2_DRIVER_CLASS(/*CS=D8*/ SS, /*DC=D3*/ 0, /*RST=D4*/ 2, /*BUSY=D2*/ 4));
+#else
+GxEPD2_4G<GxEPD2_DRIVER_CLASS, MAX_HEIGHT(GxEPD2_DRIVER_CLASS)> display(GxEPD2_DRIVER_CLASS(/*CS=10*/ SS, /*DC=*/ 8, /*RST=*/ 9, /*BUSY=*/ 7));
+#endif
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println();
+  Serial.println("setup");
+  display.init(115200);
+  greyBars();
+  delay(2000);
+  greyText();
+  display.hibernate();
+  Serial.println("setup done");
+}
+
+void loop()
+{
+}
+
+// 4 bars, white, light grey, dark grey and black, with the name of the level in the contrasting color
+void greyBars()
+{
+  const uint16_t colors[] = {GxEPD_WHITE, GxEPD_LIGHTGREY, GxEPD_DARKGREY, GxEPD_BLACK};
+  const char* names[] = {"white", "light grey", "dark grey", "black"};
+  display.setRotation(1);
+  display.setFont(&FreeMonoBold9pt7b);
+  display.setFullWindow();
+  display.firstPage();
+  do
+  {
+    display.fillScreen(GxEPD_WHITE);
+    uint16_t h = display.height() / 4;
+    for (uint16_t i = 0; i < 4; i++)
+    {
+      display.fillRect(0, i * h, display.width(), h, colors[i]);
+      display.setTextColor(i < 2 ? GxEPD_BLACK : GxEPD_WHITE);
+      display.setCursor(8, i * h + h / 2 + 5);
+      display.print(names[i]);
+    }
+  }
+  while (display.nextPage());
+}
+
+// text in each grey level on white, and a grey scale of colors quantized by luminance
+void greyText()
+{
+  const uint16_t colors[] = {GxEPD_BLACK, GxEPD_DARKGREY, GxEPD_LIGHTGREY};
+  display.setRotation(1);
+  display.setFont(&FreeMonoBold9pt7b);
+  display.setFullWindow();
+  display.firstPage();
+  do
+  {
+    display.fillScreen(GxEPD_WHITE);
+    for (uint16_t i = 0; i < 3; i++)
+    {
+      display.setTextColor(colors[i]);
+      display.setCursor(8, 20 + i * 20);
+      display.print("Hello Grey World!");
+    }
+    uint16_t w = display.width() / 16, y = 80, h = display.height() - y;
+    for (uint16_t i = 0; i < 16; i++)
+    {
+      uint16_t grey = 255 - i * 17; // 565 color of grey value
+      display.fillRect(i * w, y, w, h, ((grey & 0xF8) << 8) | ((grey & 0xFC) << 3) | (grey >> 3));
+    }
+  }
+  while (display.nextPage());
+}
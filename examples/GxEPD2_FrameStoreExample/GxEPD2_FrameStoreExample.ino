@@ -0,0 +1,123 @@
+// GxEPD2_FrameStoreExample : compressed full screen buffer for 3-color panels too large for a full screen buffer in RAM
+//
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// purpose is to show how to use setFrameStore() of GxEPD2_3C:
+// - the screen is drawn once, as with a full screen buffer, then shown with display()
+// - the page buffer holds GxEPD2_FRAME_SLOTS pages, drawing to another page compresses the least recently used one to the store
+// - the scene has circles and diagonal lines, each of them draws to several pages in turn
+//
+// the scene is then drawn again with paged drawing, and each page is compared with the rows decoded from the frame store;
+// this shows the picture a second time, and prints "frame store check ok" if frame store and paged drawing are the same
+
+// see GxEPD2_wiring_examples.h of GxEPD2_Example for wiring suggestions and examples
+// if you use a different wiring, you need to adapt the constructor parameters!
+
+#if defined(__AVR)
+#error "this example needs more RAM than AVR processors have"
+#endif
+
+#include <GxEPD2_3C.h>
+#include <Fonts/FreeMonoBold9pt7b.h>
+
+// page_height 0 : only 1 row in the class, the page buffer is supplied by setBuffer()
+#if defined(ESP32)
+#define GxEPD2_DRIVER_CLASS GxEPD2_750c_Z08 // GDEW075Z08 800x480, 96000 bytes for a full screen buffer
+GxEPD2_3C<GxEPD2_DRIVER_CLASS, 0> display(GxEPD2_DRIVER_CLASS(/*CS=5*/ SS, /*DC=*/ 17, /*RST=*/ 16, /*BUSY=*/ 4));
+#define STORE_SIZE 40000
+#else
+#define GxEPD2_DRIVER_CLASS GxEPD2_420c // GDEW042Z15 400x300, 30000 bytes for a full screen buffer
+GxEPD2_3C<GxEPD2_DRIVER_CLASS, 0> display(GxEPD2_DRIVER_CLASS(/*CS=D8*/ SS, /*DC=D3*/ 0, /*RST=D4*/ 2, /*BUSY=D2*/ 4));
+#define STORE_SIZE 24000
+#endif
+
+// a page buffer holds PAGE_ROWS rows of the black plane and PAGE_ROWS rows of the color plane, of WIDTH / 8 bytes each;
+// in frame store mode it holds GxEPD2_FRAME_SLOTS pages of PAGE_ROWS / GxEPD2_FRAME_SLOTS rows
+#define PAGE_ROWS 16
+#define ROW_BYTES (GxEPD2_DRIVER_CLASS::WIDTH / 8)
+#if PAGE_ROWS % GxEPD2_FRAME_SLOTS
+#error "the check needs PAGE_ROWS to be a multiple of GxEPD2_FRAME_SLOTS"
+#endif
+
+uint8_t page_buffer[2 * PAGE_ROWS * ROW_BYTES];
+uint8_t store_buffer[STORE_SIZE];
+uint8_t check_buffer[(PAGE_ROWS / GxEPD2_FRAME_SLOTS) * ROW_BYTES];
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println();
+  Serial.println("setup");
+  display.init(115200);
+  display.setBuffer(page_buffer, sizeof(page_buffer));
+  if (!display.setFrameStore(store_buffer, sizeof(store_buffer)))
+  {
+    Serial.println("store too small for the white screen");
+    return;
+  }
+  uint32_t start = micros();
+  display.fillScreen(GxEPD_WHITE);
+  drawScene();
+  Serial.print("drawing to frame store "); Serial.print(micros() - start); Serial.println(" us");
+  display.display(); // writes the pages from the store
+  Serial.print("frame store uses "); Serial.print(display.frameStoreUsed()); Serial.println(" bytes");
+  if (display.frameStoreOverflow()) Serial.println("frame store overflow, increase STORE_SIZE");
+  else if (checkFrameStore()) Serial.println("frame store check ok");
+  else Serial.println("frame store check FAILED");
+  display.hibernate();
+  Serial.println("setup done");
+}
+
+void loop()
+{
+}
+
+void drawScene()
+{
+  for (int16_t i = 0; i < 18; i++)
+  {
+    display.drawCircle(display.width() / 2, display.height() / 2, 10 + i * display.height() / 40, i % 2 ? GxEPD_RED : GxEPD_BLACK);
+  }
+  display.drawLine(0, 0, display.width() - 1, display.height() - 1, GxEPD_BLACK);
+  display.drawLine(display.width() - 1, 0, 0, display.height() - 1, GxEPD_RED);
+  display.fillRect(0, 0, display.width(), 24, GxEPD_BLACK);
+  display.setFont(&FreeMonoBold9pt7b);
+  display.setTextColor(GxEPD_WHITE);
+  display.setCursor(4, 17);
+  display.print("frame store");
+}
+
+// draws the scene with paged drawing, compares each page with the same rows of the frame store
+// frame store: a record per page: size of the encoded planes, 32 bit little endian, then black and color plane run length encoded
+bool checkFrameStore()
+{
+  const uint16_t store_rows = PAGE_ROWS / GxEPD2_FRAME_SLOTS;
+  const uint8_t* record = store_buffer;
+  uint16_t page_ys = 0;
+  bool same = true;
+  display.setBuffer(page_buffer, sizeof(page_buffer)); // ends frame store mode, the records in store_buffer are kept
+  display.firstPage();
+  do
+  {
+    drawScene();
+    for (uint16_t y = 0; (y < PAGE_ROWS) && (page_ys + y < display.epd2.HEIGHT); y += store_rows)
+    {
+      uint16_t rows = display.epd2.HEIGHT - page_ys - y; // the last page may have less rows
+      uint32_t n = uint32_t(rows < store_rows ? rows : store_rows) * ROW_BYTES;
+      record = GxEPD2_rleDecode(record + 4, check_buffer, n);
+      if (memcmp(check_buffer, page_buffer + y * ROW_BYTES, n)) same = false;
+      record = GxEPD2_rleDecode(record, check_buffer, n);
+      if (memcmp(check_buffer, page_buffer + (PAGE_ROWS + y) * ROW_BYTES, n)) same = false;
+    }
+    page_ys += PAGE_ROWS;
+  }
+  while (display.nextPage());
+  return same;
+}
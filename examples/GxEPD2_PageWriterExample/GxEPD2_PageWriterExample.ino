@@ -0,0 +1,157 @@
+// GxEPD2_PageWriterExample : paged drawing with caller supplied page buffers, background page writer and band parallel drawing
+//
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// purpose is to show how to wire up the paged drawing helpers, for large panels on ESP32:
+// - setBuffer()      : page buffer in caller supplied memory, the page height is as many rows as fit
+// - setPageWriter()  : second page buffer and a page writer task, the next page is drawn while the last one is transferred
+// - drawBands()      : the rows of a page are drawn in parallel, by the calling task and band worker tasks
+// - GxEPD2_DisplayList : the scene is drawn once and replayed per page and per band
+// - setPageStore()   : the second phase of a partial update is written from a compressed copy, without drawing again
+//
+// on other processors GxEPD2_PageWriter is used for writer and workers, it runs the jobs in the foreground, the results are the same
+
+// see GxEPD2_wiring_examples.h of GxEPD2_Example for wiring suggestions and examples
+// if you use a different wiring, you need to adapt the constructor parameters!
+
+#if defined(__AVR)
+#error "this example needs more RAM than AVR processors have"
+#endif
+
+#include <GxEPD2_BW.h>
+#include <GxEPD2_DisplayList.h>
+
+// page_height 0 : only 1 row in the class, the page buffer is supplied by setBuffer()
+#if defined(ESP32)
+#define GxEPD2_DRIVER_CLASS GxEPD2_750_T7 // GDEW075T7 800x480
+GxEPD2_BW<GxEPD2_DRIVER_CLASS, 0> display(GxEPD2_DRIVER_CLASS(/*CS=5*/ SS, /*DC=*/ 17, /*RST=*/ 16, /*BUSY=*/ 4));
+#else
+#define GxEPD2_DRIVER_CLASS GxEPD2_154_D67 // GDEH0154D67 200x200
+GxEPD2_BW<GxEPD2_DRIVER_CLASS, 0> display(GxEPD2_DRIVER_CLASS(/*CS=D8*/ SS, /*DC=D3*/ 0, /*RST=D4*/ 2, /*BUSY=D2*/ 4));
+#endif
+
+// buffer sizes: a page buffer holds PAGE_ROWS rows of WIDTH / 8 bytes;
+// the second page buffer for the page writer must be at least as large, else setPageWriter() disables the page writer
+#if defined(ESP32)
+#define PAGE_ROWS 120 // 4 pages of 12000 bytes on 800x480
+#define LIST_SIZE 8000 // 800 records of 10 bytes, each text character needs about 15 records
+#define STORE_SIZE 16000 // run length encoded copies of all pages, for the second phase of partial updates
+#else
+#define PAGE_ROWS 40
+#define LIST_SIZE 3000
+#define STORE_SIZE 0 // not enough RAM
+#endif
+
+uint8_t page_buffer[PAGE_ROWS * (GxEPD2_DRIVER_CLASS::WIDTH / 8)];
+uint8_t back_buffer[PAGE_ROWS * (GxEPD2_DRIVER_CLASS::WIDTH / 8)];
+uint8_t list_buffer[LIST_SIZE];
+#if STORE_SIZE > 0
+uint8_t store_buffer[STORE_SIZE];
+#endif
+
+// the Arduino sketch runs on core 1 of ESP32, the writer and the band workers run on core 0;
+// writer and workers are separate objects, a writer used as worker would wait for the transfer before each band
+#if defined(ESP32)
+GxEPD2_TaskPageWriter page_writer(0);
+GxEPD2_TaskPageWriter band_worker(0);
+#else
+GxEPD2_PageWriter page_writer;
+GxEPD2_PageWriter band_worker;
+#endif
+GxEPD2_PageWriter* band_workers[] = {&band_worker};
+
+GxEPD2_DisplayList list(display.width(), display.height(), list_buffer, sizeof(list_buffer));
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println();
+  Serial.println("setup");
+  display.init(115200);
+  display.setBuffer(page_buffer, sizeof(page_buffer));
+  display.setPageWriter(&page_writer, back_buffer, sizeof(back_buffer));
+#if STORE_SIZE > 0
+  display.setPageStore(store_buffer, sizeof(store_buffer));
+#endif
+  // the display list has the size of the display for rotation 0, keep rotation 0 or create the list after setRotation()
+  drawScene(list, 0);
+  if (list.overflow()) Serial.println("display list overflow, increase LIST_SIZE");
+  Serial.print("display list uses "); Serial.print(list.used()); Serial.println(" bytes");
+  fullRefresh();
+  delay(1000);
+  for (uint16_t i = 1; i <= 5; i++)
+  {
+    partialRefresh(i);
+    delay(1000);
+  }
+  display.hibernate();
+  Serial.println("setup done");
+}
+
+void loop()
+{
+}
+
+// any Adafruit_GFX drawing code, here drawn once to the display list;
+// filled shapes and text are recorded as few rectangles, single pixels of lines and outlined circles need a record each
+void drawScene(GxEPD2_GFX_ROOT_CLASS& target, uint16_t count)
+{
+  target.fillScreen(GxEPD_WHITE); // restarts the list
+  int16_t cell = target.width() / 6;
+  for (int16_t y = 24 + cell / 2; y + cell <= target.height(); y += cell)
+  {
+    for (int16_t x = cell / 2; x + cell <= target.width(); x += cell)
+    {
+      target.drawRect(x, y, cell - 4, cell - 4, GxEPD_BLACK);
+    }
+  }
+  target.fillCircle(target.width() / 2, (target.height() + 24) / 2, target.height() / 5, GxEPD_BLACK);
+  target.fillRect(0, 0, target.width(), 24, GxEPD_BLACK);
+  target.setTextColor(GxEPD_WHITE);
+  target.setTextSize(2);
+  target.setCursor(4, 4);
+  target.print("bands ");
+  target.print(count);
+}
+
+// render callback of drawBands(), runs on the band workers too: draws only to band
+void renderBand(GxEPD2_GFX_ROOT_CLASS& band, const void* p)
+{
+  ((GxEPD2_DisplayList*)p)->replay(band);
+}
+
+void fullRefresh()
+{
+  uint32_t start = micros();
+  display.setFullWindow();
+  display.firstPage();
+  do
+  {
+    // the page writer transfers the previous page while the bands of this page are drawn
+    display.drawBands(renderBand, &list, band_workers, sizeof(band_workers) / sizeof(band_workers[0]));
+  }
+  while (display.nextPage());
+  Serial.print("fullRefresh "); Serial.print(micros() - start); Serial.println(" us");
+}
+
+void partialRefresh(uint16_t count)
+{
+  uint32_t start = micros();
+  // the header line only, the list is recorded again with the new count, its first record covers the whole screen
+  drawScene(list, count);
+  display.setPartialWindow(0, 0, display.width(), 24);
+  display.firstPage();
+  do
+  {
+    display.drawBands(renderBand, &list, band_workers, sizeof(band_workers) / sizeof(band_workers[0]));
+  }
+  while (display.nextPage()); // second phase from the page store, if it fits, else the loop runs again
+  Serial.print("partialRefresh "); Serial.print(micros() - start); Serial.println(" us");
+}
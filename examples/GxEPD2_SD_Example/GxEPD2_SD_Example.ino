@@ -37,6 +37,7 @@
 #include <GxEPD2_BW.h>
 #include <GxEPD2_3C.h>
 #include <GxEPD2_7C.h>
+#include <GxEPD2_Dither.h>
 #include <Fonts/FreeMonoBold9pt7b.h>
 
 #if defined(ESP32)
@@ -290,6 +291,15 @@ uint8_t mono_palette_buffer[max_palette_pixels / 8]; // palette buffer for depth
 uint8_t color_palette_buffer[max_palette_pixels / 8]; // palette buffer for depth <= 8 c/w
 uint16_t rgb_palette_buffer[max_palette_pixels]; // palette buffer for depth <= 8 for buffered graphics, needed for 7-color display
 
+// 24 bit bitmaps are dithered row by row, if a row fits in input_buffer; Floyd-Steinberg needs one row of error state,
+// without state (AVR: not enough RAM) GxEPD2_Dither uses ordered (Bayer) dithering instead
+#if defined(__AVR)
+static const uint16_t dither_state_pixels = 0;
+#else
+static const uint16_t dither_state_pixels = input_buffer_pixels;
+#endif
+int16_t dither_state[GxEPD2_DITHER_STATE(dither_state_pixels, 3, 1)];
+
 void drawBitmapFromSD(const char *filename, int16_t x, int16_t y, bool with_color)
 {
   SdFile file;
@@ -377,10 +387,25 @@ void drawBitmapFromSD(const char *filename, int16_t x, int16_t y, bool with_colo
             color_palette_buffer[pn / 8] |= colored << pn % 8;
           }
         }
+        bool dither = (depth == 24) && (rowSize <= sizeof(input_buffer));
+        GxEPD2_Dither dither_rows(with_color && display.epd2.hasColor ? GxEPD2_Dither::ThreeColor : GxEPD2_Dither::BW);
+        if (dither)
+        {
+          dither_rows.begin(w, dither_state, sizeof(dither_state));
+          memset(output_row_color_buffer, 0xFF, sizeof(output_row_color_buffer)); // not written for BW
+        }
         display.clearScreen();
         uint32_t rowPosition = flip ? imageOffset + (height - h) * rowSize : imageOffset;
         for (uint16_t row = 0; row < h; row++, rowPosition += rowSize) // for each line
         {
+          if (dither)
+          {
+            file.seekSet(rowPosition);
+            file.read(input_buffer, rowSize);
+            dither_rows.rgbRow(input_buffer, output_row_mono_buffer, output_row_color_buffer, true); // .bmp is BGR
+            display.writeImage(output_row_mono_buffer, output_row_color_buffer, x, y + (flip ? h - row - 1 : row), w, 1);
+            continue;
+          }
           uint32_t in_remain = rowSize;
           uint32_t in_idx = 0;
           uint32_t in_bytes = 0;
@@ -568,15 +593,26 @@ void drawBitmapFromSD_Buffered(const char *filename, int16_t x, int16_t y, bool
             rgb_palette_buffer[pn] = ((red & 0xF8) << 8) | ((green & 0xFC) << 3) | ((blue & 0xF8) >> 3);
           }
         }
+        bool dither = (depth == 24) && (rowSize <= sizeof(input_buffer)) && !(with_color && has_multicolors);
+        GxEPD2_Dither dither_rows(with_color && display.epd2.hasColor ? GxEPD2_Dither::ThreeColor : GxEPD2_Dither::BW);
         if (partial_update) display.setPartialWindow(x, y, w, h);
         else display.setFullWindow();
         display.firstPage();
         do
         {
           //if (!overwrite) display.fillScreen(GxEPD_WHITE);
+          if (dither) dither_rows.begin(w, dither_state, sizeof(dither_state)); // all rows for each page, drawRow() clips to the page
           uint32_t rowPosition = flip ? imageOffset + (height - h) * rowSize : imageOffset;
           for (uint16_t row = 0; row < h; row++, rowPosition += rowSize) // for each line
           {
+            if (dither)
+            {
+              file.seekSet(rowPosition);
+              file.read(input_buffer, rowSize);
+              dither_rows.rgbRow(input_buffer, output_row_mono_buffer, output_row_color_buffer, true); // .bmp is BGR
+              dither_rows.drawRow(display, x, y + (flip ? h - row - 1 : row), output_row_mono_buffer, output_row_color_buffer);
+              continue;
+            }
             uint32_t in_remain = rowSize;
             uint32_t in_idx = 0;
             uint32_t in_bytes = 0;
@@ -31,6 +31,7 @@
 #include <GxEPD2_BW.h>
 #include <GxEPD2_3C.h>
 #include <GxEPD2_7C.h>
+#include <GxEPD2_Dither.h>
 
 // select the display class (only one), matching the kind of display panel
 #define GxEPD2_DISPLAY_CLASS GxEPD2_BW
@@ -449,6 +450,9 @@ uint8_t mono_palette_buffer[max_palette_pixels / 8]; // palette buffer for depth
 uint8_t color_palette_buffer[max_palette_pixels / 8]; // palette buffer for depth <= 8 c/w
 uint16_t rgb_palette_buffer[max_palette_pixels]; // palette buffer for depth <= 8 for buffered graphics, needed for 7-color display
 
+// 24 bit bitmaps are dithered row by row, if a row fits in input_buffer; Floyd-Steinberg needs one row of error state
+int16_t dither_state[GxEPD2_DITHER_STATE(input_buffer_pixels, 3, 1)];
+
 void showBitmapFrom_HTTP(const char* host, const char* path, const char* filename, int16_t x, int16_t y, bool with_color)
 {
   WiFiClient client;
@@ -552,6 +556,13 @@ void showBitmapFrom_HTTP(const char* host, const char* path, const char* filenam
             color_palette_buffer[pn / 8] |= colored << pn % 8;
           }
         }
+        bool dither = (depth == 24) && (rowSize <= sizeof(input_buffer));
+        GxEPD2_Dither dither_rows(with_color && display.epd2.hasColor ? GxEPD2_Dither::ThreeColor : GxEPD2_Dither::BW);
+        if (dither)
+        {
+          dither_rows.begin(w, dither_state, sizeof(dither_state));
+          memset(output_row_color_buffer, 0xFF, sizeof(output_row_color_buffer)); // not written for BW
+        }
         display.clearScreen();
         uint32_t rowPosition = flip ? imageOffset + (height - h) * rowSize : imageOffset;
         //Serial.print("skip "); Serial.println(rowPosition - bytes_read);
@@ -560,6 +571,25 @@ void showBitmapFrom_HTTP(const char* host, const char* path, const char* filenam
         {
           if (!connection_ok || !(client.connected() || client.available())) break;
           delay(1); // yield() to avoid WDT
+          if (dither)
+          {
+            uint32_t got = read8n(client, input_buffer, rowSize);
+            while ((got < rowSize) && connection_ok)
+            {
+              uint32_t gotmore = read8n(client, input_buffer + got, rowSize - got);
+              got += gotmore;
+              connection_ok = gotmore > 0;
+            }
+            bytes_read += got;
+            if (!connection_ok)
+            {
+              Serial.print("Error: got no more after "); Serial.print(bytes_read); Serial.println(" bytes read!");
+              break;
+            }
+            dither_rows.rgbRow(input_buffer, output_row_mono_buffer, output_row_color_buffer, true); // .bmp is BGR
+            display.writeImage(output_row_mono_buffer, output_row_color_buffer, x, y + (flip ? h - row - 1 : row), w, 1);
+            continue;
+          }
           uint32_t in_remain = rowSize;
           uint32_t in_idx = 0;
           uint32_t in_bytes = 0;
@@ -784,6 +814,9 @@ void drawBitmapFrom_HTTP_ToBuffer(const char* host, const char* path, const char
             rgb_palette_buffer[pn] = ((red & 0xF8) << 8) | ((green & 0xFC) << 3) | ((blue & 0xF8) >> 3);
           }
         }
+        bool dither = (depth == 24) && (rowSize <= sizeof(input_buffer)) && !(with_color && has_multicolors);
+        GxEPD2_Dither dither_rows(with_color && display.epd2.hasColor ? GxEPD2_Dither::ThreeColor : GxEPD2_Dither::BW);
+        if (dither) dither_rows.begin(w, dither_state, sizeof(dither_state)); // all rows for each page, drawRow() clips to the page
         uint32_t rowPosition = flip ? imageOffset + (height - h) * rowSize : imageOffset;
         //Serial.print("skip "); Serial.println(rowPosition - bytes_read);
         bytes_read += skip(client, rowPosition - bytes_read);
@@ -791,6 +824,25 @@ void drawBitmapFrom_HTTP_ToBuffer(const char* host, const char* path, const char
         {
           if (!connection_ok || !(client.connected() || client.available())) break;
           delay(1); // yield() to avoid WDT
+          if (dither)
+          {
+            uint32_t got = read8n(client, input_buffer, rowSize);
+            while ((got < rowSize) && connection_ok)
+            {
+              uint32_t gotmore = read8n(client, input_buffer + got, rowSize - got);
+              got += gotmore;
+              connection_ok = gotmore > 0;
+            }
+            bytes_read += got;
+            if (!connection_ok)
+            {
+              Serial.print("Error: got no more after "); Serial.print(bytes_read); Serial.println(" bytes read!");
+              break;
+            }
+            dither_rows.rgbRow(input_buffer, output_row_mono_buffer, output_row_color_buffer, true); // .bmp is BGR
+            dither_rows.drawRow(display, x, y + (flip ? h - row - 1 : row), output_row_mono_buffer, output_row_color_buffer);
+            continue;
+          }
           uint32_t in_remain = rowSize;
           uint32_t in_idx = 0;
           uint32_t in_bytes = 0;
@@ -1030,6 +1082,13 @@ void showBitmapFrom_HTTPS(const char* host, const char* path, const char* filena
             color_palette_buffer[pn / 8] |= colored << pn % 8;
           }
         }
+        bool dither = (depth == 24) && (rowSize <= sizeof(input_buffer));
+        GxEPD2_Dither dither_rows(with_color && display.epd2.hasColor ? GxEPD2_Dither::ThreeColor : GxEPD2_Dither::BW);
+        if (dither)
+        {
+          dither_rows.begin(w, dither_state, sizeof(dither_state));
+          memset(output_row_color_buffer, 0xFF, sizeof(output_row_color_buffer)); // not written for BW
+        }
         display.clearScreen();
         uint32_t rowPosition = flip ? imageOffset + (height - h) * rowSize : imageOffset;
         //Serial.print("skip "); Serial.println(rowPosition - bytes_read);
@@ -1038,6 +1097,25 @@ void showBitmapFrom_HTTPS(const char* host, const char* path, const char* filena
         {
           if (!connection_ok || !(client.connected() || client.available())) break;
           delay(1); // yield() to avoid WDT
+          if (dither)
+          {
+            uint32_t got = read8n(client, input_buffer, rowSize);
+            while ((got < rowSize) && connection_ok)
+            {
+              uint32_t gotmore = read8n(client, input_buffer + got, rowSize - got);
+              got += gotmore;
+              connection_ok = gotmore > 0;
+            }
+            bytes_read += got;
+            if (!connection_ok)
+            {
+              Serial.print("Error: got no more after "); Serial.print(bytes_read); Serial.println(" bytes read!");
+              break;
+            }
+            dither_rows.rgbRow(input_buffer, output_row_mono_buffer, output_row_color_buffer, true); // .bmp is BGR
+            display.writeImage(output_row_mono_buffer, output_row_color_buffer, x, y + (flip ? h - row - 1 : row), w, 1);
+            continue;
+          }
           uint32_t in_remain = rowSize;
           uint32_t in_idx = 0;
           uint32_t in_bytes = 0;
@@ -1272,6 +1350,9 @@ void drawBitmapFrom_HTTPS_ToBuffer(const char* host, const char* path, const cha
             rgb_palette_buffer[pn] = ((red & 0xF8) << 8) | ((green & 0xFC) << 3) | ((blue & 0xF8) >> 3);
           }
         }
+        bool dither = (depth == 24) && (rowSize <= sizeof(input_buffer)) && !(with_color && has_multicolors);
+        GxEPD2_Dither dither_rows(with_color && display.epd2.hasColor ? GxEPD2_Dither::ThreeColor : GxEPD2_Dither::BW);
+        if (dither) dither_rows.begin(w, dither_state, sizeof(dither_state)); // all rows for each page, drawRow() clips to the page
         uint32_t rowPosition = flip ? imageOffset + (height - h) * rowSize : imageOffset;
         //Serial.print("skip "); Serial.println(rowPosition - bytes_read);
         bytes_read += skip(client, rowPosition - bytes_read);
@@ -1279,6 +1360,25 @@ void drawBitmapFrom_HTTPS_ToBuffer(const char* host, const char* path, const cha
         {
           if (!connection_ok || !(client.connected() || client.available())) break;
           delay(1); // yield() to avoid WDT
+          if (dither)
+          {
+            uint32_t got = read8n(client, input_buffer, rowSize);
+            while ((got < rowSize) && connection_ok)
+            {
+              uint32_t gotmore = read8n(client, input_buffer + got, rowSize - got);
+              got += gotmore;
+              connection_ok = gotmore > 0;
+            }
+            bytes_read += got;
+            if (!connection_ok)
+            {
+              Serial.print("Error: got no more after "); Serial.print(bytes_read); Serial.println(" bytes read!");
+              break;
+            }
+            dither_rows.rgbRow(input_buffer, output_row_mono_buffer, output_row_color_buffer, true); // .bmp is BGR
+            dither_rows.drawRow(display, x, y + (flip ? h - row - 1 : row), output_row_mono_buffer, output_row_color_buffer);
+            continue;
+          }
           uint32_t in_remain = rowSize;
           uint32_t in_idx = 0;
           uint32_t in_bytes = 0;
@@ -0,0 +1,189 @@
+// GxEPD2_replay : replays command stream logs recorded with GxEPD2_Recorder on a host, reports sizes and timing
+//
+// build: g++ -O2 -o GxEPD2_replay GxEPD2_replay.cpp, in extras/replay, uses ../../src/GxEPD2_MockSpi.h
+// usage: GxEPD2_replay [-f spi_frequency] log [log2]
+//        with two logs, the second is compared to the first, e.g. for logs of two releases
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "../../src/GxEPD2_MockSpi.h" // same counters and hash as the library
+
+enum Event {Command = 0x01, Data = 0x02, Data1 = 0x03, Busy = 0x04};
+
+struct CommandStats
+{
+  uint32_t count;
+  uint32_t data_bytes;
+};
+
+struct Report
+{
+  GxEPD2_MockSpi transport;
+  uint32_t records, commands, data_bytes, busy_waits;
+  uint64_t busy_time; // us
+  uint32_t first_time, last_time;
+  bool has_time;
+  CommandStats command_stats[256];
+  std::vector<uint16_t> stream; // commands as 0x100 | command and data bytes, as GxEPD2_MockSpi hashes them, for comparison
+};
+
+static uint32_t get32(const uint8_t* p)
+{
+  return p[0] | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+// extends the time span covered by the log, timestamps are micros() and may wrap
+static void mark(Report& r, uint32_t start, uint32_t end)
+{
+  if (!r.has_time)
+  {
+    r.first_time = start;
+    r.last_time = end;
+    r.has_time = true;
+    return;
+  }
+  if (int32_t(start - r.first_time) < 0) r.first_time = start;
+  if (int32_t(end - r.last_time) > 0) r.last_time = end;
+}
+
+static bool replay(const char* filename, Report& r)
+{
+  FILE* f = fopen(filename, "rb");
+  if (!f)
+  {
+    fprintf(stderr, "can't open %s\n", filename);
+    return false;
+  }
+  std::vector<uint8_t> log;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) log.insert(log.end(), buf, buf + n);
+  fclose(f);
+  memset(r.command_stats, 0, sizeof(r.command_stats));
+  r.transport.reset();
+  r.stream.clear();
+  r.records = r.commands = r.data_bytes = r.busy_waits = 0;
+  r.busy_time = 0;
+  r.has_time = false;
+  int last_command = -1;
+  size_t i = 0;
+  while (i < log.size())
+  {
+    const uint8_t* p = &log[i];
+    size_t left = log.size() - i;
+    size_t size = 0;
+    switch (p[0])
+    {
+      case Command: size = 6; break;
+      case Data: size = left < 3 ? 3 : 3 + (p[1] | (size_t(p[2]) << 8)); break;
+      case Data1: size = 2; break;
+      case Busy: size = 9; break;
+      default:
+        fprintf(stderr, "%s: unknown record 0x%02x at offset %u\n", filename, p[0], unsigned(i));
+        return false;
+    }
+    if (left < size)
+    {
+      fprintf(stderr, "%s: truncated record at offset %u\n", filename, unsigned(i));
+      break;
+    }
+    switch (p[0])
+    {
+      case Command:
+        mark(r, get32(p + 1), get32(p + 1));
+        r.transport.setDC(false);
+        r.transport.transfer(p[5]);
+        r.transport.setDC(true);
+        r.commands++;
+        r.stream.push_back(0x100 | p[5]);
+        last_command = p[5];
+        r.command_stats[last_command].count++;
+        break;
+      case Data:
+      case Data1:
+        {
+          const uint8_t* data = p[0] == Data ? p + 3 : p + 1;
+          size_t count = p[0] == Data ? size - 3 : 1;
+          for (size_t j = 0; j < count; j++)
+          {
+            r.transport.transfer(data[j]);
+            r.stream.push_back(data[j]);
+          }
+          r.data_bytes += count;
+          if (last_command >= 0) r.command_stats[last_command].data_bytes += count;
+        }
+        break;
+      case Busy:
+        mark(r, get32(p + 1), get32(p + 1) + get32(p + 5));
+        r.busy_waits++;
+        r.busy_time += get32(p + 5);
+        break;
+    }
+    r.records++;
+    i += size;
+  }
+  return true;
+}
+
+static void print(const char* filename, Report& r, double spi_frequency)
+{
+  printf("%s\n", filename);
+  printf("  records     : %u\n", r.records);
+  printf("  commands    : %u\n", r.commands);
+  printf("  data bytes  : %u\n", r.data_bytes);
+  printf("  total bytes : %u, hash 0x%08x\n", r.transport.bytes, r.transport.hash);
+  double spi_time = r.transport.bytes * 8.0 / spi_frequency * 1e6;
+  printf("  spi time    : %.0f us at %.0f Hz (estimated)\n", spi_time, spi_frequency);
+  printf("  busy waits  : %u, %.0f us\n", r.busy_waits, double(r.busy_time));
+  if (r.has_time)
+  {
+    double span = double(uint32_t(r.last_time - r.first_time));
+    printf("  span        : %.0f us (first to last timestamp)\n", span);
+    printf("  other time  : %.0f us (span - busy - spi, e.g. rendering)\n", span - double(r.busy_time) - spi_time);
+  }
+  printf("  command  count  data bytes\n");
+  for (int c = 0; c < 256; c++)
+  {
+    if (r.command_stats[c].count) printf("     0x%02x %6u %11u\n", c, r.command_stats[c].count, r.command_stats[c].data_bytes);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  double spi_frequency = 4000000;
+  int arg = 1;
+  if ((argc > 2) && (strcmp(argv[1], "-f") == 0))
+  {
+    spi_frequency = atof(argv[2]);
+    arg = 3;
+  }
+  if ((argc - arg < 1) || (argc - arg > 2) || (spi_frequency <= 0))
+  {
+    fprintf(stderr, "usage: %s [-f spi_frequency] log [log2]\n", argv[0]);
+    return 2;
+  }
+  static Report r1, r2;
+  if (!replay(argv[arg], r1)) return 1;
+  print(argv[arg], r1, spi_frequency);
+  if (argc - arg == 1) return 0;
+  if (!replay(argv[arg + 1], r2)) return 1;
+  print(argv[arg + 1], r2, spi_frequency);
+  printf("compare\n");
+  printf("  bytes       : %+d\n", int(r2.transport.bytes) - int(r1.transport.bytes));
+  printf("  commands    : %+d\n", int(r2.commands) - int(r1.commands));
+  printf("  busy time   : %+.0f us\n", double(r2.busy_time) - double(r1.busy_time));
+  if (r1.stream == r2.stream)
+  {
+    printf("  streams are identical\n");
+    return 0;
+  }
+  size_t i = 0;
+  while ((i < r1.stream.size()) && (i < r2.stream.size()) && (r1.stream[i] == r2.stream[i])) i++;
+  printf("  streams differ at byte %u\n", unsigned(i));
+  return 1;
+}
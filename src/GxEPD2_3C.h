@@ -29,7 +29,21 @@
 #define GxEPD2_GFX_BASE_CLASS Adafruit_GFX
 #endif
 
+#ifndef GxEPD2_GFX_ROOT_CLASS
+#define GxEPD2_GFX_ROOT_CLASS GxEPD2_GFX_BASE_CLASS
+#endif
+
 #include "GxEPD2_EPD.h"
+#include "GxEPD2_RLE.h"
+#include "GxEPD2_PageWriter.h"
+#include "GxEPD2_PageCull.h"
+#include "GxEPD2_Band.h"
+#include "GxEPD2_RowHash.h"
+// pages kept decoded in frame store mode, the page buffer is split into as many pages; a page is encoded back to
+// the frame store only when its slot is needed for another page, e.g. a circle touches 4 pages at a time
+#ifndef GxEPD2_FRAME_SLOTS
+#define GxEPD2_FRAME_SLOTS 4
+#endif
 #include "epd3c/GxEPD2_154c.h"
 #include "epd3c/GxEPD2_154_Z90c.h"
 #include "epd3c/GxEPD2_213c.h"
@@ -42,24 +56,33 @@
 #include "epd3c/GxEPD2_750c_Z08.h"
 #include "epd3c/GxEPD2_750c_Z90.h"
 
-template<typename GxEPD2_Type, const uint16_t page_height>
+// GxEPD2_Transport : bus transport, see GxEPD2_Transport.h
+template<typename GxEPD2_Type, const uint16_t page_height, typename GxEPD2_Transport = GxEPD2_HwSpi>
 class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
 {
   public:
     GxEPD2_Type epd2;
+    // buffer, size : optional page buffer, see setBuffer()
 #if ENABLE_GxEPD2_GFX
-    GxEPD2_3C(GxEPD2_Type epd2_instance) : GxEPD2_GFX_BASE_CLASS(epd2, GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
+    GxEPD2_3C(GxEPD2_Type epd2_instance, uint8_t* buffer = 0, uint32_t size = 0) : GxEPD2_GFX_BASE_CLASS(epd2, GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
 #else
-    GxEPD2_3C(GxEPD2_Type epd2_instance) : GxEPD2_GFX_BASE_CLASS(GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
+    GxEPD2_3C(GxEPD2_Type epd2_instance, uint8_t* buffer = 0, uint32_t size = 0) : GxEPD2_GFX_BASE_CLASS(GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
 #endif
     {
-      _page_height = page_height;
-      _pages = (HEIGHT / _page_height) + ((HEIGHT % _page_height) > 0);
       _mirror = false;
       _using_partial_mode = false;
       _current_page = 0;
+      _frame_page_locked = false;
+      _invalidateRowHashes();
+      epd2.setBus(_bus);
+      setBuffer(buffer, size);
       setFullWindow();
     }
+    // the transport of epd2, e.g. display.transport().setPins(sck, mosi); for GxEPD2_SwSpi
+    GxEPD2_Transport& transport()
+    {
+      return _bus.transport;
+    };
 
     uint16_t pages()
     {
@@ -79,46 +102,34 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
 
     void drawPixel(int16_t x, int16_t y, uint16_t color)
     {
-      if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return;
-      if (_mirror) x = width() - x - 1;
-      // check rotation, move pixel around if necessary
-      switch (getRotation())
-      {
-        case 1:
-          _swap_(x, y);
-          x = WIDTH - x - 1;
-          break;
-        case 2:
-          x = WIDTH - x - 1;
-          y = HEIGHT - y - 1;
-          break;
-        case 3:
-          _swap_(x, y);
-          y = HEIGHT - y - 1;
-          break;
-      }
-      // transpose partial window to 0,0
-      x -= _pw_x;
-      y -= _pw_y;
-      // clip to (partial) window
-      if ((x < 0) || (x >= _pw_w) || (y < 0) || (y >= _pw_h)) return;
-      // adjust for current page
-      y -= _current_page * _page_height;
-      // check if in current page
-      if ((y < 0) || (y >= _page_height)) return;
-      uint16_t i = x / 8 + y * (_pw_w / 8);
-      _black_buffer[i] = (_black_buffer[i] | (1 << (7 - x % 8))); // white
-      _color_buffer[i] = (_color_buffer[i] | (1 << (7 - x % 8)));
-      if (color == GxEPD_WHITE) return;
-      else if (color == GxEPD_BLACK) _black_buffer[i] = (_black_buffer[i] & (0xFF ^ (1 << (7 - x % 8))));
-      else if ((color == GxEPD_RED) || (color == GxEPD_YELLOW)) _color_buffer[i] = (_color_buffer[i] & (0xFF ^ (1 << (7 - x % 8))));
+      _drawPixel(x, y, color, 0, _page_height);
+    }
+
+    // span kernels: the transform is done once per primitive, rows are filled bytewise with edge masks
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+    {
+      fillRect(x, y, w, 1, color);
+    }
+
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+    {
+      fillRect(x, y, 1, h, color);
+    }
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      uint16_t xs, ys, xe, ye;
+      if (_frame_store && !_frame_page_locked) return _frameFillRect(x, y, w, h, color);
+      if (!_bufferRect(x, y, w, h, xs, ys, xe, ye)) return;
+      _fillBuffer(xs, ys, xe, ye, color);
     }
 
     void init(uint32_t serial_diag_bitrate = 0) // = 0 : disabled
     {
+      _invalidateRowHashes();
       epd2.init(serial_diag_bitrate);
       _using_partial_mode = false;
-      _current_page = 0;
+      if (!_frame_store) _current_page = 0; // else the page in the page buffer
       setFullWindow();
     }
 
@@ -129,9 +140,10 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
     // pulldown_rst_mode true for alternate RST handling to avoid feeding 5V through RST pin
     void init(uint32_t serial_diag_bitrate, bool initial, uint16_t reset_duration = 20, bool pulldown_rst_mode = false)
     {
+      _invalidateRowHashes();
       epd2.init(serial_diag_bitrate, initial, reset_duration, pulldown_rst_mode);
       _using_partial_mode = false;
-      _current_page = 0;
+      if (!_frame_store) _current_page = 0; // else the page in the page buffer
       setFullWindow();
     }
 
@@ -142,21 +154,42 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
       if (color == GxEPD_WHITE);
       else if (color == GxEPD_BLACK) black = 0x00;
       else if ((color == GxEPD_RED) || (color == GxEPD_YELLOW)) red = 0x00;
-      for (uint16_t x = 0; x < sizeof(_black_buffer); x++)
-      {
-        _black_buffer[x] = black;
-        _color_buffer[x] = red;
-      }
+      memset(_black_buffer, black, uint32_t(_page_height) * (WIDTH / 8));
+      memset(_color_buffer, red, uint32_t(_page_height) * (WIDTH / 8));
+      if (_frame_store && !_frame_page_locked) _frameFill(); // all pages
     }
 
     // display buffer content to screen, useful for full screen buffer
     void display(bool partial_update_mode = false)
     {
+      if (_frame_store) return _displayFrame(partial_update_mode);
+      if (_rowsUnchanged()) return;
+#if ENABLE_GxEPD2_ROW_HASH
+      if (partial_update_mode && (_page_height >= GxEPD2_Type::HEIGHT)) return _row_hash.displayChanged(*this, false);
+#endif
       epd2.writeImage(_black_buffer, _color_buffer, 0, 0, WIDTH, _page_height);
       epd2.refresh(partial_update_mode);
       if (!partial_update_mode) epd2.powerOff();
     }
 
+    // asynchronous display(): returns while the screen refreshes, call poll() until it returns false
+    void displayAsync(bool partial_update_mode = false)
+    {
+      if (_frame_store) _writeFrame(0, 0, WIDTH, HEIGHT);
+      else
+      {
+        if (_rowsUnchanged()) return;
+        epd2.writeImage(_black_buffer, _color_buffer, 0, 0, WIDTH, _page_height);
+      }
+      epd2.refreshAsync(partial_update_mode, partial_update_mode ? GxEPD2_EPD::AsyncNone : GxEPD2_EPD::AsyncPowerOff);
+    }
+
+    // advances asynchronous display, returns true while in progress
+    bool poll()
+    {
+      return epd2.poll();
+    }
+
     // display part of buffer content to screen, useful for full screen buffer
     // displayWindow, use parameters according to actual rotation.
     // x and w should be multiple of 8, for rotation 0 or 2,
@@ -165,12 +198,14 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
     // this is an addressing limitation of the e-paper controllers
     void displayWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
     {
+      _invalidateRowHashes();
       x = gx_uint16_min(x, width());
       y = gx_uint16_min(y, height());
       w = gx_uint16_min(w, width() - x);
       h = gx_uint16_min(h, height() - y);
       _rotate(x, y, w, h);
-      epd2.writeImagePart(_black_buffer, _color_buffer, x, y, WIDTH, _page_height, x, y, w, h);
+      if (_frame_store) _writeFrame(x, y, w, h);
+      else epd2.writeImagePart(_black_buffer, _color_buffer, x, y, WIDTH, _page_height, x, y, w, h);
       epd2.refresh(x, y, w, h);
     }
 
@@ -190,7 +225,7 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
     // this is an addressing limitation of the e-paper controllers
     void setPartialWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
     {
-      if (!epd2.hasPartialUpdate) return;
+      if (!epd2.hasPartialUpdate || _frame_store) return; // frame store: use displayWindow()
       _pw_x = gx_uint16_min(x, width());
       _pw_y = gx_uint16_min(y, height());
       _pw_w = gx_uint16_min(w, width() - _pw_x);
@@ -203,19 +238,76 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
       _pw_x -= _pw_x % 8;
     }
 
+    // page buffer in caller supplied memory of any size, e.g. PSRAM on ESP32 or a scratch area shared with other code,
+    // instead of the buffer of page_height rows in the class; the page height is as many rows as fit, up to HEIGHT;
+    // buffer 0 returns to the internal buffer; use page_height 0 for an internal buffer of only 1 row; ends frame store mode
+    void setBuffer(uint8_t* buffer, uint32_t size)
+    {
+      _frame_store = 0; // the records are pages of the page buffer
+      uint32_t rows = buffer ? size / (2 * (GxEPD2_Type::WIDTH / 8)) : 0;
+      _buffer = rows ? buffer : _internal_buffer;
+      _buffer_rows = rows ? (rows < GxEPD2_Type::HEIGHT ? rows : GxEPD2_Type::HEIGHT) : _internal_rows;
+      _splitBuffer(1);
+      _current_page = 0;
+      _invalidateRowHashes();
+    }
+
+    // compressed full screen buffer, for panels too large for a full screen buffer in RAM, e.g. 96KB for 7.5" 3-color:
+    // the pages of the screen are kept run length encoded in store, the page buffer holds GxEPD2_FRAME_SLOTS pages drawing goes to,
+    // drawing to another page compresses the least recently used one back and loads that one;
+    // e-paper screens are mostly blank, 5 to 10 times smaller;
+    // the screen is drawn once, as with a full screen buffer, display() or nextPage() write it from store, page by page;
+    // use a page buffer of 16 to 64 rows, see setBuffer(); setPartialWindow() is not available, use displayWindow();
+    // returns false if store is too small for the white screen; store 0 ends frame store mode, as does setBuffer()
+    bool setFrameStore(uint8_t* store, uint32_t size)
+    {
+      _frame_store = 0;
+      _splitBuffer(store ? GxEPD2_FRAME_SLOTS : 1);
+      setFullWindow();
+      _current_page = 0;
+      fillScreen(GxEPD_WHITE);
+      if (!store) return true;
+      _frame_store = store;
+      _frame_size = size;
+      _frame_overflow = false;
+      _frameFill(); // ends frame store mode if store is too small
+      if (_frame_store) return true;
+      _splitBuffer(1);
+      fillScreen(GxEPD_WHITE);
+      return false;
+    }
+
+    // bytes used in frame store
+    uint32_t frameStoreUsed()
+    {
+      return _frame_store ? _frame_used : 0;
+    }
+
+    // true if a page didn't fit in frame store after drawing, it was kept as before; use a larger store or paged drawing
+    bool frameStoreOverflow()
+    {
+      return _frame_store && _frame_overflow;
+    }
+
     void firstPage()
     {
       fillScreen(GxEPD_WHITE);
-      _current_page = 0;
+      if (!_frame_store) _current_page = 0; // else the page in the page buffer
       _second_phase = false;
       epd2.setPaged(); // for GxEPD2_154c paged workaround
     }
 
     bool nextPage()
     {
+      if (_frame_store) // drawn once
+      {
+        display(false);
+        return false;
+      }
       uint16_t page_ys = _current_page * _page_height;
       if (_using_partial_mode)
       {
+        _invalidateRowHashes();
         //Serial.print("  nextPage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(_pw_y); Serial.print(", ");
         //Serial.print(_pw_w); Serial.print(", "); Serial.print(_pw_h); Serial.print(") P"); Serial.println(_current_page);
         uint16_t page_ye = _current_page < (_pages - 1) ? page_ys + _page_height : HEIGHT;
@@ -253,11 +345,20 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
       }
       else // full update
       {
-        epd2.writeImage(_black_buffer, _color_buffer, 0, page_ys, WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+        uint16_t page_rows = gx_uint16_min(_page_height, HEIGHT - page_ys);
+        bool write = true;
+#if ENABLE_GxEPD2_ROW_HASH
+        // pages the same as in the last frame sent are not written, the controller still has them
+        write = _second_phase ? _row_hash.changed(page_ys, page_ys + page_rows) : _row_hash.hashRows(page_ys, page_ys + page_rows, _black_buffer, _color_buffer);
+#endif
+        if (write) epd2.writeImage(_black_buffer, _color_buffer, 0, page_ys, WIDTH, page_rows);
         _current_page++;
         if (_current_page == _pages)
         {
           _current_page = 0;
+#if ENABLE_GxEPD2_ROW_HASH
+          if (!_second_phase && !_row_hash.changed()) return false; // same as last frame sent, no refresh
+#endif
           if ((epd2.panel == GxEPD2::GDEW0154Z04) && (_pages > 1))
           {
             if (!_second_phase)
@@ -280,6 +381,13 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
     // GxEPD style paged drawing; drawCallback() is called as many times as needed
     void drawPaged(void (*drawCallback)(const void*), const void* pv)
     {
+      if (_frame_store) // drawn once
+      {
+        fillScreen(GxEPD_WHITE);
+        drawCallback(pv);
+        return display(false);
+      }
+      _invalidateRowHashes();
       if (_using_partial_mode)
       {
         for (_current_page = 0; _current_page < _pages; _current_page++)
@@ -323,105 +431,189 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
       _current_page = 0;
     }
 
-    void drawInvertedBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+    // band parallel drawing to the page buffer, e.g. to the full screen buffer of a large panel:
+    // the rows of the current page are split into bands, one per worker and one for the calling task;
+    // render(band, p) draws the scene to a band, on all of them in parallel, and drawBands() returns when all are done;
+    // render must draw only to band, e.g. with GxEPD2_DisplayList::replay(band), as it runs on the workers, see GxEPD2_PageWriter.h
+    // in frame store mode the bands of each page are drawn in turn
+    void drawBands(void (*render)(GxEPD2_GFX_ROOT_CLASS& band, const void* p), const void* p, GxEPD2_PageWriter* workers[] = 0, uint8_t count = 0)
     {
-      // taken from Adafruit_GFX.cpp, modified
-      int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-      uint8_t byte = 0;
-      for (int16_t j = 0; j < h; j++)
+      if (_frame_store && !_frame_page_locked)
       {
-        for (int16_t i = 0; i < w; i++ )
+        for (uint16_t page = 0; _frameLockNext(page, 0, 0, width(), height()); page++) drawBands(render, p, workers, count);
+        return;
+      }
+      uint16_t ys = gx_uint16_min(_current_page * _page_height, _pw_h);
+      uint16_t rows = gx_uint16_min(_page_height, _pw_h - ys);
+      GxEPD2_Band<GxEPD2_3C>::drawBands(*this, rows, render, p, workers, count);
+    }
+
+    // bounds of the current page in drawing coordinates, according to rotation, mirror and partial window;
+    // only pixels inside go to the buffer, e.g. drawPaged() callbacks can skip whole widgets outside, see pageIntersects()
+    // in frame store mode the whole screen is on the page
+    void getPageBounds(int16_t& x, int16_t& y, int16_t& w, int16_t& h)
+    {
+      if (_frame_store && !_frame_page_locked) return _pageBounds(0, _pw_h, x, y, w, h);
+      _pageBounds(_current_page * _page_height, _page_height, x, y, w, h);
+    }
+
+    // true if the rectangle is (partly) on the current page
+    bool pageIntersects(int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      if ((w <= 0) || (h <= 0)) return false;
+      return _pageIntersects(x, y, int32_t(x) + w, int32_t(y) + h);
+    }
+
+    // page culling, see GxEPD2_PageCull.h: lines outside the current page are skipped
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+    {
+      if (!_pageCull().intersectsLine(x0, y0, x1, y1)) return;
+      GxEPD2_GFX_BASE_CLASS::drawLine(x0, y0, x1, y1, color);
+    }
+
+    // bitmaps are drawn for the rows and columns on the current page only
+    using GxEPD2_GFX_BASE_CLASS::drawBitmap;
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, color, false, false, true);
+    }
+
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, bg, true, false, true);
+    }
+
+    void drawBitmap(int16_t x, int16_t y, uint8_t* bitmap, int16_t w, int16_t h, uint16_t color)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, color, false, false, false);
+    }
+
+    void drawBitmap(int16_t x, int16_t y, uint8_t* bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, bg, true, false, false);
+    }
+
+#if ENABLE_GxEPD2_TEXT_CULLING
+    // characters outside the current page are not drawn, the cursor advances and wraps as in Adafruit_GFX::write()
+    using GxEPD2_GFX_BASE_CLASS::write;
+    size_t write(uint8_t c)
+    {
+      int16_t cx = cursor_x, cy = cursor_y, bx, by, bw, bh;
+      if (!GxEPD2_PageCull::charBox(c, gfxFont, textsize_x, textsize_y, wrap, _width, cx, cy, bx, by, bw, bh)) return GxEPD2_GFX_BASE_CLASS::write(c);
+      if (_frame_store && !_frame_page_locked) // frame store mode: once for each page the character touches
+      {
+        int16_t x0 = cursor_x, y0 = cursor_y;
+        bool drawn = false;
+        for (uint16_t page = 0; _frameLockNext(page, bx, by, int32_t(bx) + bw, int32_t(by) + bh); page++)
         {
-          if (i & 7) byte <<= 1;
-          else
-          {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-            byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-#else
-            byte = bitmap[j * byteWidth + i / 8];
-#endif
-          }
-          if (!(byte & 0x80))
-          {
-            drawPixel(x + i, y + j, color);
-          }
+          cursor_x = x0;
+          cursor_y = y0;
+          GxEPD2_GFX_BASE_CLASS::write(c);
+          drawn = true;
         }
+        if (drawn) return 1;
       }
+      if (_pageIntersects(bx, by, int32_t(bx) + bw, int32_t(by) + bh)) return GxEPD2_GFX_BASE_CLASS::write(c); // wraps the same way
+      cursor_x = cx;
+      cursor_y = cy;
+      return 1;
+    }
+#endif
+
+    void drawInvertedBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, color, false, true, true);
     }
 
     //  Support for Bitmaps (Sprites) to Controller Buffer and to Screen
     void clearScreen(uint8_t value = 0xFF) // init controller memory and screen (default white)
     {
+      _invalidateRowHashes();
       epd2.clearScreen(value);
     }
     void writeScreenBuffer(uint8_t value = 0xFF) // init controller memory (default white)
     {
+      _invalidateRowHashes();
       epd2.writeScreenBuffer(value);
     }
     // write to controller memory, without screen refresh; x and w should be multiple of 8
     void writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
     {
+      _invalidateRowHashes();
       epd2.writeImage(bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                         int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
     {
+      _invalidateRowHashes();
       epd2.writeImagePart(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _invalidateRowHashes();
       epd2.writeImage(black, color, x, y, w, h, invert, mirror_y, pgm);
     }
     void writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h)
     {
+      _invalidateRowHashes();
       epd2.writeImage(black, color, x, y, w, h, false, false, false);
     }
     void writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                         int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _invalidateRowHashes();
       epd2.writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                         int16_t x, int16_t y, int16_t w, int16_t h)
     {
+      _invalidateRowHashes();
       epd2.writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, false, false, false);
     }
     // write sprite of native data to controller memory, without screen refresh; x and w should be multiple of 8
     void writeNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _invalidateRowHashes();
       epd2.writeNative(data1, data2, x, y, w, h, invert, mirror_y, pgm);
     }
     // write to controller memory, with screen refresh; x and w should be multiple of 8
     void drawImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
     {
+      _invalidateRowHashes();
       epd2.drawImage(bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void drawImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                         int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
     {
+      _invalidateRowHashes();
       epd2.drawImagePart(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _invalidateRowHashes();
       epd2.drawImage(black, color, x, y, w, h, invert, mirror_y, pgm);
     }
     void drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h)
     {
+      _invalidateRowHashes();
       epd2.drawImage(black, color, x, y, w, h, false, false, false);
     }
     void drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                         int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _invalidateRowHashes();
       epd2.drawImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                         int16_t x, int16_t y, int16_t w, int16_t h)
     {
+      _invalidateRowHashes();
       epd2.drawImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, false, false, false);
     }
     // write sprite of native data to controller memory, with screen refresh; x and w should be multiple of 8
     void drawNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _invalidateRowHashes();
       epd2.drawNative(data1, data2, x, y, w, h, invert, mirror_y, pgm);
     }
     void refresh(bool partial_update_mode = false) // screen refresh from controller memory to full screen
@@ -441,9 +633,11 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
     // turns powerOff() and sets controller to deep sleep for minimum power use, ONLY if wakeable by RST (rst >= 0)
     void hibernate()
     {
+      _invalidateRowHashes();
       epd2.hibernate();
     }
   private:
+    friend class GxEPD2_Band<GxEPD2_3C>;
     template <typename T> static inline void
     _swap_(T & a, T & b)
     {
@@ -479,10 +673,432 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
           break;
       }
     }
+    // inverse of _rotate(), from panel to drawing coordinates
+    void _unrotate(uint16_t& x, uint16_t& y, uint16_t& w, uint16_t& h)
+    {
+      switch (getRotation())
+      {
+        case 1:
+          _swap_(x, y);
+          _swap_(w, h);
+          y = WIDTH - y - h;
+          break;
+        case 2:
+          x = WIDTH - x - w;
+          y = HEIGHT - y - h;
+          break;
+        case 3:
+          _swap_(x, y);
+          _swap_(w, h);
+          x = HEIGHT - x - w;
+          break;
+      }
+    }
+    // true if x0 <= x < x1, y0 <= y < y1 in drawing coordinates intersects the current page
+    bool _pageIntersects(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+    {
+      return _pageCull().intersects(x0, y0, x1, y1);
+    }
+    GxEPD2_PageCull _pageCull()
+    {
+      int16_t x, y, w, h;
+      getPageBounds(x, y, w, h);
+      return GxEPD2_PageCull(x, y, w, h);
+    }
+    // bounds of the (partial) window rows ys <= y < ys + rows in drawing coordinates
+    void _pageBounds(uint16_t ys, uint16_t rows, int16_t& x, int16_t& y, int16_t& w, int16_t& h)
+    {
+      ys = gx_uint16_min(ys, _pw_h);
+      uint16_t px = _pw_x, py = _pw_y + ys, pw = _pw_w, ph = gx_uint16_min(rows, _pw_h - ys);
+      _unrotate(px, py, pw, ph);
+      if (_mirror) px = width() - px - pw;
+      x = px;
+      y = py;
+      w = pw;
+      h = ph;
+    }
+    // draws the part of a bitmap on the current page, set bits with color, clear bits with bg if use_bg; invert swaps set and clear
+    void _drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg, bool use_bg, bool invert, bool pgm)
+    {
+      if (_frame_store && !_frame_page_locked) // frame store mode: the part on each page the bitmap touches
+      {
+        for (uint16_t page = 0; _frameLockNext(page, x, y, int32_t(x) + w, int32_t(y) + h); page++)
+        {
+          _drawBitmap(x, y, bitmap, w, h, color, bg, use_bg, invert, pgm);
+        }
+        return;
+      }
+      _pageCull().drawBitmap(*this, x, y, bitmap, w, h, color, bg, use_bg, invert, pgm);
+    }
+    // draws a pixel to rows clip_ys <= y < clip_ye of the page buffer
+    void _drawPixel(int16_t x, int16_t y, uint16_t color, uint16_t clip_ys, uint16_t clip_ye)
+    {
+      if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return;
+      if (_mirror) x = width() - x - 1;
+      // check rotation, move pixel around if necessary
+      switch (getRotation())
+      {
+        case 1:
+          _swap_(x, y);
+          x = WIDTH - x - 1;
+          break;
+        case 2:
+          x = WIDTH - x - 1;
+          y = HEIGHT - y - 1;
+          break;
+        case 3:
+          _swap_(x, y);
+          y = HEIGHT - y - 1;
+          break;
+      }
+      // transpose partial window to 0,0
+      x -= _pw_x;
+      y -= _pw_y;
+      // clip to (partial) window
+      if ((x < 0) || (x >= _pw_w) || (y < 0) || (y >= _pw_h)) return;
+      if (_frame_store && !_frame_page_locked) _framePage(y / _page_height); // the page of the pixel
+      // adjust for current page
+      y -= _current_page * _page_height;
+      // check if in current page
+      if ((y < clip_ys) || (y >= clip_ye)) return;
+      uint32_t i = x / 8 + uint32_t(y) * (_pw_w / 8);
+      _black_buffer[i] = (_black_buffer[i] | (1 << (7 - x % 8))); // white
+      _color_buffer[i] = (_color_buffer[i] | (1 << (7 - x % 8)));
+      if (color == GxEPD_WHITE) return;
+      else if (color == GxEPD_BLACK) _black_buffer[i] = (_black_buffer[i] & (0xFF ^ (1 << (7 - x % 8))));
+      else if ((color == GxEPD_RED) || (color == GxEPD_YELLOW)) _color_buffer[i] = (_color_buffer[i] & (0xFF ^ (1 << (7 - x % 8))));
+    }
+    // fills the buffer window xs <= x < xe, ys <= y < ye
+    void _fillBuffer(uint16_t xs, uint16_t ys, uint16_t xe, uint16_t ye, uint16_t color)
+    {
+      uint8_t black = (color == GxEPD_BLACK) ? 0x00 : 0xFF;
+      uint8_t red = ((color == GxEPD_RED) || (color == GxEPD_YELLOW)) ? 0x00 : 0xFF;
+      uint16_t row_bytes = _pw_w / 8;
+      if ((xs == 0) && (xe == _pw_w)) // whole rows
+      {
+        memset(_black_buffer + ys * row_bytes, black, (ye - ys) * row_bytes);
+        memset(_color_buffer + ys * row_bytes, red, (ye - ys) * row_bytes);
+      }
+      else for (uint16_t y1 = ys; y1 < ye; y1++)
+      {
+        _fillSpan(_black_buffer + y1 * row_bytes, xs, xe, black);
+        _fillSpan(_color_buffer + y1 * row_bytes, xs, xe, red);
+      }
+    }
+    // transforms a rectangle to the buffer of the current page, as drawPixel() does for a pixel
+    // result is the buffer window xs <= x < xe, ys <= y < ye, false if nothing is visible; clip_ys, clip_ye : rows of the page buffer
+    bool _bufferRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t& xs, uint16_t& ys, uint16_t& xe, uint16_t& ye, uint16_t clip_ys = 0, uint16_t clip_ye = 0xFFFF)
+    {
+      int32_t x0, y0, x1, y1;
+      if (!_windowRect(x, y, w, h, x0, y0, x1, y1)) return false;
+      // adjust for current page and clip
+      y0 -= int32_t(_current_page) * _page_height;
+      y1 -= int32_t(_current_page) * _page_height;
+      if (y0 < clip_ys) y0 = clip_ys;
+      if (y1 > _page_height) y1 = _page_height;
+      if (y1 > clip_ye) y1 = clip_ye;
+      if ((x0 >= x1) || (y0 >= y1)) return false;
+      xs = x0;
+      xe = x1;
+      ys = y0;
+      ye = y1;
+      return true;
+    }
+    // transforms a rectangle to the (partial) window, result x0 <= x < x1, y0 <= y < y1 may be empty, false if off screen
+    bool _windowRect(int16_t x, int16_t y, int16_t w, int16_t h, int32_t& x0, int32_t& y0, int32_t& x1, int32_t& y1)
+    {
+      x0 = x;
+      y0 = y;
+      x1 = int32_t(x) + w;
+      y1 = int32_t(y) + h;
+      if (w < 0) // negative width extends to the left, as in Adafruit_SPITFT
+      {
+        x0 = x1 + 1;
+        x1 = int32_t(x) + 1;
+      }
+      if (h < 0)
+      {
+        y0 = y1 + 1;
+        y1 = int32_t(y) + 1;
+      }
+      // clip to screen
+      if (x0 < 0) x0 = 0;
+      if (y0 < 0) y0 = 0;
+      if (x1 > width()) x1 = width();
+      if (y1 > height()) y1 = height();
+      if ((x0 >= x1) || (y0 >= y1)) return false;
+      uint16_t rx = x0, ry = y0, rw = x1 - x0, rh = y1 - y0;
+      if (_mirror) rx = width() - rx - rw;
+      _rotate(rx, ry, rw, rh);
+      // transpose partial window to 0,0 and clip
+      x0 = int32_t(rx) - _pw_x;
+      y0 = int32_t(ry) - _pw_y;
+      x1 = x0 + rw;
+      y1 = y0 + rh;
+      if (x0 < 0) x0 = 0;
+      if (y0 < 0) y0 = 0;
+      if (x1 > _pw_w) x1 = _pw_w;
+      if (y1 > _pw_h) y1 = _pw_h;
+      return true;
+    }
+    // frame store mode: fills the part of the rectangle on each page it touches
+    void _frameFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      int32_t x0, y0, x1, y1;
+      if (!_windowRect(x, y, w, h, x0, y0, x1, y1) || (x0 >= x1) || (y0 >= y1)) return;
+      for (uint16_t page = y0 / _page_height; int32_t(page) * _page_height < y1; page++)
+      {
+        int32_t page_ys = int32_t(page) * _page_height;
+        _framePage(page);
+        _fillBuffer(x0, y0 > page_ys ? y0 - page_ys : 0, x1, y1 - page_ys < _page_height ? y1 - page_ys : _page_height, color);
+      }
+    }
+    // frame store mode: loads the next page from page on that x0 <= x < x1, y0 <= y < y1 touches, drawing is clipped to it,
+    // for primitives drawn once for each page; false after the last one
+    bool _frameLockNext(uint16_t& page, int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+    {
+      for (; page < _pages; page++)
+      {
+        int16_t px, py, pw, ph;
+        _pageBounds(page * _page_height, _page_height, px, py, pw, ph);
+        if ((x1 > px) && (x0 < px + pw) && (y1 > py) && (y0 < py + ph))
+        {
+          _framePage(page);
+          _frame_page_locked = true;
+          return true;
+        }
+      }
+      _frame_page_locked = false;
+      return false;
+    }
+    // frame store mode: drawing goes to page, switches to its slot, loads it to the least recently used slot if it isn't there
+    void _framePage(uint16_t page)
+    {
+      if (page != _current_page) _frameLoad(page);
+      _frame_slot_dirty[_frame_slot] = true;
+    }
+    void _frameLoad(uint16_t page)
+    {
+      uint8_t slot = 0;
+      for (uint8_t s = 1; s < _frame_slots; s++)
+      {
+        if (_frame_slot_used[s] < _frame_slot_used[slot]) slot = s;
+      }
+      for (uint8_t s = 0; s < _frame_slots; s++)
+      {
+        if (_frame_slot_page[s] == page) slot = s;
+      }
+      if (_frame_slot_page[slot] != page)
+      {
+        _frameFlush(slot);
+        uint32_t plane = uint32_t(gx_uint16_min(_page_height, HEIGHT - page * _page_height)) * (WIDTH / 8);
+        GxEPD2_rleDecode(GxEPD2_rleDecode(_frameRecord(page) + 4, _frameBlack(slot), plane), _frameBlack(slot) + _plane_size, plane);
+        _frame_slot_page[slot] = page;
+      }
+      _frame_slot_used[slot] = ++_frame_ticks;
+      _frameSelect(slot);
+      _current_page = page;
+    }
+    // frame store mode: encodes the slot back to the record of its page, if drawn to;
+    // the following records are moved to the end of store, the page is encoded into the gap behind its old record
+    // and replaces it; if it doesn't fit, the old record is kept and frameStoreOverflow() is set
+    void _frameFlush(uint8_t slot)
+    {
+      if (!_frame_slot_dirty[slot]) return;
+      _frame_slot_dirty[slot] = false;
+      uint16_t page = _frame_slot_page[slot];
+      uint8_t* r = _frameRecord(page);
+      uint8_t* tail = r + 4 + _get32(r);
+      uint32_t tail_size = _frame_used - (tail - _frame_store);
+      uint8_t* moved = _frame_store + _frame_size - tail_size;
+      memmove(moved, tail, tail_size);
+      uint32_t n = _frameEncode(page, slot, tail, moved - tail);
+      if (n)
+      {
+        memmove(r, tail, n);
+        tail = r + n;
+      }
+      else _frame_overflow = true;
+      memmove(tail, moved, tail_size);
+      _frame_used = (tail - _frame_store) + tail_size;
+    }
+    // frame store mode: all pages as the slot drawing goes to, e.g. after fillScreen(); the other slots are emptied;
+    // ends frame store mode if store is too small
+    void _frameFill()
+    {
+      _frame_used = 0;
+      for (uint8_t s = 0; s < _frame_slots; s++)
+      {
+        _frame_slot_page[s] = -1;
+        _frame_slot_dirty[s] = false;
+      }
+      _frame_slot_page[_frame_slot] = _current_page;
+      for (uint16_t page = 0; page < _pages; page++)
+      {
+        uint32_t n = _frameEncode(page, _frame_slot, _frame_store + _frame_used, _frame_size - _frame_used);
+        if (!n)
+        {
+          _frame_overflow = true;
+          _frame_store = 0;
+          return;
+        }
+        _frame_used += n;
+      }
+    }
+    // frame store mode: record of page: size of the encoded planes, 32 bit little endian, black and color plane run length encoded
+    uint8_t* _frameRecord(uint16_t page)
+    {
+      uint8_t* r = _frame_store;
+      for (uint16_t i = 0; i < page; i++) r += 4 + _get32(r);
+      return r;
+    }
+    // encodes slot as record of page to r, returns the record size, 0 if it doesn't fit in room
+    uint32_t _frameEncode(uint16_t page, uint8_t slot, uint8_t* r, uint32_t room)
+    {
+      uint32_t plane = uint32_t(gx_uint16_min(_page_height, HEIGHT - page * _page_height)) * (WIDTH / 8);
+      uint32_t nb = room > 4 ? GxEPD2_rleEncode(_frameBlack(slot), plane, r + 4, room - 4) : 0;
+      uint32_t nc = nb ? GxEPD2_rleEncode(_frameBlack(slot) + _plane_size, plane, r + 4 + nb, room - 4 - nb) : 0;
+      if (!nc) return 0;
+      _put32(r, nb + nc);
+      return 4 + nb + nc;
+    }
+    // black plane of slot, the color plane follows
+    uint8_t* _frameBlack(uint8_t slot)
+    {
+      return _buffer + 2 * _plane_size * slot;
+    }
+    // drawing goes to slot
+    void _frameSelect(uint8_t slot)
+    {
+      _frame_slot = slot;
+      _black_buffer = _frameBlack(slot);
+      _color_buffer = _black_buffer + _plane_size;
+    }
+    // splits the page buffer into slots pages, 1 for paged drawing, GxEPD2_FRAME_SLOTS for frame store mode
+    void _splitBuffer(uint8_t slots)
+    {
+      if (slots > _buffer_rows) slots = _buffer_rows;
+      _frame_slots = slots;
+      _page_height = _buffer_rows / slots;
+      _plane_size = uint32_t(_page_height) * (WIDTH / 8);
+      _pages = (HEIGHT / _page_height) + ((HEIGHT % _page_height) > 0);
+      for (uint8_t s = 0; s < slots; s++)
+      {
+        _frame_slot_page[s] = -1;
+        _frame_slot_dirty[s] = false;
+        _frame_slot_used[s] = 0;
+      }
+      _frame_ticks = 0;
+      _frameSelect(0);
+    }
+    static uint32_t _get32(const uint8_t* p)
+    {
+      return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+    }
+    static void _put32(uint8_t* p, uint32_t value)
+    {
+      p[0] = value;
+      p[1] = value >> 8;
+      p[2] = value >> 16;
+      p[3] = value >> 24;
+    }
+    // frame store mode: writes the screen rows y <= row < y + h, columns x <= col < x + w to the controller,
+    // decoded from store to the page buffer, as many pages as the slots hold at a time, as for paged drawing
+    void _writeFrame(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+      for (uint8_t s = 0; s < _frame_slots; s++) _frameFlush(s);
+      _splitBuffer(_frame_slots); // the slots are overwritten
+      _current_page = -1;
+      uint16_t rows = _page_height * _frame_slots;
+      uint32_t plane = uint32_t(rows) * (WIDTH / 8);
+      const uint8_t* r = _frame_store;
+      for (uint16_t rows_ys = 0; rows_ys < HEIGHT; rows_ys += rows)
+      {
+        uint16_t rows_ye = gx_uint16_min(rows_ys + rows, HEIGHT);
+        uint16_t ys = gx_uint16_max(y, rows_ys), ye = gx_uint16_min(y + h, rows_ye);
+        uint8_t* black = _buffer;
+        for (uint16_t page_ys = rows_ys; page_ys < rows_ye; page_ys += _page_height)
+        {
+          uint32_t n = uint32_t(gx_uint16_min(_page_height, HEIGHT - page_ys)) * (WIDTH / 8);
+          if (ys < ye) GxEPD2_rleDecode(GxEPD2_rleDecode(r + 4, black, n), black + plane, n);
+          black += n;
+          r += 4 + _get32(r);
+        }
+        if (ys >= ye) continue;
+        if ((x == 0) && (w == WIDTH) && (ys == rows_ys)) epd2.writeImage(_buffer, _buffer + plane, 0, ys, WIDTH, ye - ys);
+        else epd2.writeImagePart(_buffer, _buffer + plane, x, ys - rows_ys, WIDTH, rows_ye - rows_ys, x, ys, w, ye - ys);
+      }
+    }
+    // frame store mode display()
+    void _displayFrame(bool partial_update_mode)
+    {
+      _invalidateRowHashes();
+      if ((epd2.panel == GxEPD2::GDEW0154Z04) && (_page_height * _frame_slots < HEIGHT))
+      { // GxEPD2_154c paged workaround: black part first, then color part
+        epd2.setPaged();
+        _writeFrame(0, 0, WIDTH, HEIGHT);
+      }
+      _writeFrame(0, 0, WIDTH, HEIGHT);
+      epd2.refresh(partial_update_mode);
+      if (!partial_update_mode) epd2.powerOff();
+    }
+    void _invalidateRowHashes()
+    {
+#if ENABLE_GxEPD2_ROW_HASH
+      _row_hash.invalidate();
+#endif
+    }
+    // with ENABLE_GxEPD2_ROW_HASH and full screen buffer: true if the buffers are the same as the last frame sent
+    bool _rowsUnchanged()
+    {
+#if ENABLE_GxEPD2_ROW_HASH
+      if (_page_height >= GxEPD2_Type::HEIGHT) return !_row_hash.hashRows(0, HEIGHT, _black_buffer, _color_buffer);
+#endif
+      _invalidateRowHashes();
+      return false;
+    }
+#if ENABLE_GxEPD2_ROW_HASH
+    template<uint16_t, uint16_t> friend class GxEPD2_RowHash;
+    // buffer rows ys <= y < ye of the full screen buffers to the controller, for GxEPD2_RowHash::displayChanged()
+    void _writeChangedRows(uint16_t ys, uint16_t ye, bool again)
+    {
+      (void) again; // no fast partial update on 3 color panels
+      epd2.writeImagePart(_black_buffer, _color_buffer, 0, ys, WIDTH, _page_height, 0, ys, WIDTH, ye - ys);
+    }
+#endif
+    // sets the bits xs <= x < xe of a buffer row to data
+    static void _fillSpan(uint8_t* row, uint16_t xs, uint16_t xe, uint8_t data)
+    {
+      uint16_t bs = xs / 8, be = (xe - 1) / 8;
+      uint8_t ms = 0xFF >> (xs % 8), me = 0xFF << (7 - (xe - 1) % 8);
+      if (bs == be) ms &= me;
+      row[bs] = (row[bs] & ~ms) | (data & ms);
+      if (bs == be) return;
+      memset(row + bs + 1, data, be - bs - 1);
+      row[be] = (row[be] & ~me) | (data & me);
+    }
   private:
-    uint8_t _black_buffer[(GxEPD2_Type::WIDTH / 8) * page_height];
-    uint8_t _color_buffer[(GxEPD2_Type::WIDTH / 8) * page_height];
+    static const uint16_t _internal_rows = page_height > 0 ? page_height : 1;
+    uint8_t _internal_buffer[2 * (GxEPD2_Type::WIDTH / 8) * _internal_rows];
+    uint8_t* _buffer;
+    uint8_t* _black_buffer;
+    uint8_t* _color_buffer;
+    uint16_t _buffer_rows;
+    uint32_t _plane_size;
+    GxEPD2_TransportBus<GxEPD2_Transport> _bus;
     bool _using_partial_mode, _second_phase, _mirror;
+    uint8_t* _frame_store;
+    uint32_t _frame_size, _frame_used;
+    bool _frame_overflow, _frame_page_locked;
+    // frame store mode: page in each slot of the page buffer, -1 if none, least recently used slot is loaded next
+    int16_t _frame_slot_page[GxEPD2_FRAME_SLOTS];
+    uint32_t _frame_slot_used[GxEPD2_FRAME_SLOTS];
+    bool _frame_slot_dirty[GxEPD2_FRAME_SLOTS];
+    uint32_t _frame_ticks;
+    uint8_t _frame_slots, _frame_slot;
+#if ENABLE_GxEPD2_ROW_HASH
+    GxEPD2_RowHash<GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT> _row_hash;
+#endif
     uint16_t _width_bytes, _pixel_bytes;
     int16_t _current_page;
     uint16_t _pages, _page_height;
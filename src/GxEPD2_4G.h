@@ -0,0 +1,640 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// based on Demo Example from Good Display: http://www.e-paper-display.com/download_list/downloadcategoryid=34&isMode=false.html
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// 4 grey levels on b/w panels with a grey waveform, for drivers with writeImage_4G(), e.g. GxEPD2_290_T94, GxEPD2_420
+//
+// buffer of 2 bit pixels, 4 pixels per byte, first pixel in the high bits: 3 white, 2 light grey, 1 dark grey, 0 black;
+// colors are quantized by luminance, GxEPD_LIGHTGREY and GxEPD_DARKGREY select the grey levels;
+// the driver writes the two controller buffers from the grey bits of each row, and refreshes full screen with the grey waveform;
+// partial windows are written as such, but the refresh is full screen, the rest of the controller memory should hold grey content
+
+#ifndef _GxEPD2_4G_H_
+#define _GxEPD2_4G_H_
+// uncomment next line to use class GFX of library GFX_Root instead of Adafruit_GFX
+//#include <GFX.h>
+
+#ifndef ENABLE_GxEPD2_GFX
+// default is off
+#define ENABLE_GxEPD2_GFX 0
+#endif
+
+#if ENABLE_GxEPD2_GFX
+#include "GxEPD2_GFX.h"
+#define GxEPD2_GFX_BASE_CLASS GxEPD2_GFX
+#elif defined(_GFX_H_)
+#define GxEPD2_GFX_BASE_CLASS GFX
+#else
+#include <Adafruit_GFX.h>
+#define GxEPD2_GFX_BASE_CLASS Adafruit_GFX
+#endif
+
+#include "GxEPD2_EPD.h"
+#include "GxEPD2_PageCull.h"
+#include "epd/GxEPD2_290_T94.h"
+#include "epd/GxEPD2_420.h"
+
+// GxEPD2_Transport : bus transport, see GxEPD2_Transport.h
+template<typename GxEPD2_Type, const uint16_t page_height, typename GxEPD2_Transport = GxEPD2_HwSpi>
+class GxEPD2_4G : public GxEPD2_GFX_BASE_CLASS
+{
+  public:
+    GxEPD2_Type epd2;
+    // buffer, size : optional page buffer, see setBuffer()
+#if ENABLE_GxEPD2_GFX
+    GxEPD2_4G(GxEPD2_Type epd2_instance, uint8_t* buffer = 0, uint32_t size = 0) : GxEPD2_GFX_BASE_CLASS(epd2, GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
+#else
+    GxEPD2_4G(GxEPD2_Type epd2_instance, uint8_t* buffer = 0, uint32_t size = 0) : GxEPD2_GFX_BASE_CLASS(GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
+#endif
+    {
+      _mirror = false;
+      _using_partial_mode = false;
+      _current_page = 0;
+      epd2.setBus(_bus);
+      setBuffer(buffer, size);
+      setFullWindow();
+    }
+    // the transport of epd2, e.g. display.transport().setPins(sck, mosi); for GxEPD2_SwSpi
+    GxEPD2_Transport& transport()
+    {
+      return _bus.transport;
+    };
+
+    uint16_t pages()
+    {
+      return _pages;
+    }
+
+    uint16_t pageHeight()
+    {
+      return _page_height;
+    }
+
+    bool mirror(bool m)
+    {
+      _swap_ (_mirror, m);
+      return m;
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color)
+    {
+      if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return;
+      if (_mirror) x = width() - x - 1;
+      // check rotation, move pixel around if necessary
+      switch (getRotation())
+      {
+        case 1:
+          _swap_(x, y);
+          x = WIDTH - x - 1;
+          break;
+        case 2:
+          x = WIDTH - x - 1;
+          y = HEIGHT - y - 1;
+          break;
+        case 3:
+          _swap_(x, y);
+          y = HEIGHT - y - 1;
+          break;
+      }
+      // transpose partial window to 0,0
+      x -= _pw_x;
+      y -= _pw_y;
+      // clip to (partial) window
+      if ((x < 0) || (x >= _pw_w) || (y < 0) || (y >= _pw_h)) return;
+      // adjust for current page
+      y -= _current_page * _page_height;
+      // check if in current page
+      if ((y < 0) || (y >= _page_height)) return;
+      uint32_t i = x / 4 + uint32_t(y) * (_pw_w / 4);
+      uint8_t shift = 2 * (3 - (x & 3));
+      _pixel_buffer[i] = (_pixel_buffer[i] & ~(0x03 << shift)) | (grey4(color) << shift);
+    }
+
+    // span kernels: the transform and color quantization are done once per primitive, rows are filled with packed pixel quads
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+    {
+      fillRect(x, y, w, 1, color);
+    }
+
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+    {
+      fillRect(x, y, 1, h, color);
+    }
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      uint16_t xs, ys, xe, ye;
+      if (!_bufferRect(x, y, w, h, xs, ys, xe, ye)) return;
+      uint8_t pv4 = grey4(color) * 0x55;
+      uint16_t row_bytes = _pw_w / 4;
+      if ((xs == 0) && (xe == _pw_w)) memset(_pixel_buffer + uint32_t(ys) * row_bytes, pv4, uint32_t(ye - ys) * row_bytes); // whole rows
+      else
+      {
+        uint16_t bs = xs / 4, be = (xe - 1) / 4; // first and last byte
+        uint8_t ms = 0xFF >> (2 * (xs & 3)), me = 0xFF << (2 * (3 - ((xe - 1) & 3))); // pixels of first and last byte
+        if (bs == be) ms &= me;
+        for (uint16_t y1 = ys; y1 < ye; y1++)
+        {
+          uint8_t* row = _pixel_buffer + uint32_t(y1) * row_bytes;
+          row[bs] = (row[bs] & ~ms) | (pv4 & ms);
+          if (be > bs)
+          {
+            if (be > bs + 1) memset(row + bs + 1, pv4, be - bs - 1);
+            row[be] = (row[be] & ~me) | (pv4 & me);
+          }
+        }
+      }
+    }
+
+    void init(uint32_t serial_diag_bitrate = 0) // = 0 : disabled
+    {
+      epd2.init(serial_diag_bitrate);
+      _using_partial_mode = false;
+      _current_page = 0;
+      setFullWindow();
+    }
+
+    // init method with additional parameters:
+    // initial false for re-init after processor deep sleep wake up, if display power supply was kept
+    // only relevant for b/w displays with fast partial update
+    // reset_duration = 20 is default; a value of 2 may help with "clever" reset circuit of newer boards from Waveshare
+    // pulldown_rst_mode true for alternate RST handling to avoid feeding 5V through RST pin
+    void init(uint32_t serial_diag_bitrate, bool initial, uint16_t reset_duration = 20, bool pulldown_rst_mode = false)
+    {
+      epd2.init(serial_diag_bitrate, initial, reset_duration, pulldown_rst_mode);
+      _using_partial_mode = false;
+      _current_page = 0;
+      setFullWindow();
+    }
+
+    void fillScreen(uint16_t color)
+    {
+      memset(_pixel_buffer, grey4(color) * 0x55, uint32_t(_page_height) * (WIDTH / 4));
+    }
+
+    // display buffer content to screen, useful for full screen buffer
+    // the grey refresh is always a full refresh, partial_update_mode only keeps the panel powered on
+    void display(bool partial_update_mode = false)
+    {
+      epd2.writeImage_4G(_pixel_buffer, 0, 0, WIDTH, _page_height);
+      epd2.refresh(partial_update_mode);
+      if (!partial_update_mode) epd2.powerOff();
+    }
+
+    // asynchronous display(): returns while the screen refreshes, call poll() until it returns false
+    void displayAsync(bool partial_update_mode = false)
+    {
+      epd2.writeImage_4G(_pixel_buffer, 0, 0, WIDTH, _page_height);
+      epd2.refreshAsync(partial_update_mode, partial_update_mode ? GxEPD2_EPD::AsyncNone : GxEPD2_EPD::AsyncPowerOff);
+    }
+
+    // advances asynchronous display, returns true while in progress
+    bool poll()
+    {
+      return epd2.poll();
+    }
+
+    // display part of buffer content to screen, useful for full screen buffer
+    // displayWindow, use parameters according to actual rotation.
+    // x and w should be multiple of 8, for rotation 0 or 2,
+    // y and h should be multiple of 8, for rotation 1 or 3,
+    // else window is increased as needed,
+    // this is an addressing limitation of the e-paper controllers
+    void displayWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+      x = gx_uint16_min(x, width());
+      y = gx_uint16_min(y, height());
+      w = gx_uint16_min(w, width() - x);
+      h = gx_uint16_min(h, height() - y);
+      _rotate(x, y, w, h);
+      epd2.writeImagePart_4G(_pixel_buffer, x, y, WIDTH, _page_height, x, y, w, h);
+      epd2.refresh(x, y, w, h);
+    }
+
+    void setFullWindow()
+    {
+      _using_partial_mode = false;
+      _pw_x = 0;
+      _pw_y = 0;
+      _pw_w = WIDTH;
+      _pw_h = HEIGHT;
+    }
+
+    // setPartialWindow, use parameters according to actual rotation.
+    // x and w should be multiple of 8, for rotation 0 or 2,
+    // y and h should be multiple of 8, for rotation 1 or 3,
+    // else window is increased as needed,
+    // this is an addressing limitation of the e-paper controllers
+    void setPartialWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+      if (!epd2.hasPartialUpdate) return;
+      _pw_x = gx_uint16_min(x, width());
+      _pw_y = gx_uint16_min(y, height());
+      _pw_w = gx_uint16_min(w, width() - _pw_x);
+      _pw_h = gx_uint16_min(h, height() - _pw_y);
+      _rotate(_pw_x, _pw_y, _pw_w, _pw_h);
+      _using_partial_mode = true;
+      // make _pw_x, _pw_w multiple of 8
+      _pw_w += _pw_x % 8;
+      if (_pw_w % 8 > 0) _pw_w += 8 - _pw_w % 8;
+      _pw_x -= _pw_x % 8;
+    }
+
+    // page buffer in caller supplied memory of any size, e.g. PSRAM on ESP32 or a scratch area shared with other code,
+    // instead of the buffer of page_height rows in the class; the page height is as many rows as fit, up to HEIGHT;
+    // buffer 0 returns to the internal buffer; use page_height 0 for an internal buffer of only 1 row
+    void setBuffer(uint8_t* buffer, uint32_t size)
+    {
+      uint32_t rows = buffer ? size / (GxEPD2_Type::WIDTH / 4) : 0;
+      _pixel_buffer = rows ? buffer : _internal_buffer;
+      _page_height = rows ? (rows < GxEPD2_Type::HEIGHT ? rows : GxEPD2_Type::HEIGHT) : _internal_rows;
+      _pages = (HEIGHT / _page_height) + ((HEIGHT % _page_height) > 0);
+      _current_page = 0;
+    }
+
+    void firstPage()
+    {
+      fillScreen(GxEPD_WHITE);
+      _current_page = 0;
+    }
+
+    bool nextPage()
+    {
+      uint16_t page_ys = _current_page * _page_height;
+      if (_using_partial_mode)
+      {
+        uint16_t page_ye = _current_page < (_pages - 1) ? page_ys + _page_height : HEIGHT;
+        uint16_t dest_ys = _pw_y + page_ys; // transposed
+        uint16_t dest_ye = gx_uint16_min(_pw_y + _pw_h, _pw_y + page_ye);
+        if (dest_ye > dest_ys)
+        {
+          epd2.writeImage_4G(_pixel_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
+        }
+        _current_page++;
+        if (_current_page == _pages)
+        {
+          _current_page = 0;
+          epd2.refresh(_pw_x, _pw_y, _pw_w, _pw_h); // full grey refresh, no second phase
+          return false;
+        }
+        fillScreen(GxEPD_WHITE);
+        return true;
+      }
+      else // full update
+      {
+        epd2.writeImage_4G(_pixel_buffer, 0, page_ys, WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+        _current_page++;
+        if (_current_page == _pages)
+        {
+          _current_page = 0;
+          epd2.refresh(false); // full update after only phase
+          epd2.powerOff();
+          return false;
+        }
+        fillScreen(GxEPD_WHITE);
+        return true;
+      }
+    }
+
+    // GxEPD style paged drawing; drawCallback() is called as many times as needed
+    void drawPaged(void (*drawCallback)(const void*), const void* pv)
+    {
+      if (_using_partial_mode)
+      {
+        for (_current_page = 0; _current_page < _pages; _current_page++)
+        {
+          uint16_t page_ys = _current_page * _page_height;
+          uint16_t page_ye = _current_page < (_pages - 1) ? page_ys + _page_height : HEIGHT;
+          uint16_t dest_ys = _pw_y + page_ys; // transposed
+          uint16_t dest_ye = gx_uint16_min(_pw_y + _pw_h, _pw_y + page_ye);
+          if (dest_ye > dest_ys)
+          {
+            fillScreen(GxEPD_WHITE);
+            drawCallback(pv);
+            epd2.writeImage_4G(_pixel_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
+          }
+        }
+        epd2.refresh(_pw_x, _pw_y, _pw_w, _pw_h);
+      }
+      else // full update
+      {
+        for (_current_page = 0; _current_page < _pages; _current_page++)
+        {
+          uint16_t page_ys = _current_page * _page_height;
+          fillScreen(GxEPD_WHITE);
+          drawCallback(pv);
+          epd2.writeImage_4G(_pixel_buffer, 0, page_ys, WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+        }
+        epd2.refresh(false); // full update
+        epd2.powerOff();
+      }
+      _current_page = 0;
+    }
+
+    // bounds of the current page in drawing coordinates, according to rotation, mirror and partial window;
+    // only pixels inside go to the buffer, e.g. drawPaged() callbacks can skip whole widgets outside, see pageIntersects()
+    void getPageBounds(int16_t& x, int16_t& y, int16_t& w, int16_t& h)
+    {
+      uint16_t ys = gx_uint16_min(_current_page * _page_height, _pw_h);
+      uint16_t px = _pw_x, py = _pw_y + ys, pw = _pw_w, ph = gx_uint16_min(_page_height, _pw_h - ys);
+      _unrotate(px, py, pw, ph);
+      if (_mirror) px = width() - px - pw;
+      x = px;
+      y = py;
+      w = pw;
+      h = ph;
+    }
+
+    // true if the rectangle is (partly) on the current page
+    bool pageIntersects(int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      if ((w <= 0) || (h <= 0)) return false;
+      return _pageIntersects(x, y, int32_t(x) + w, int32_t(y) + h);
+    }
+
+    // page culling, see GxEPD2_PageCull.h: lines outside the current page are skipped
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+    {
+      if (!_pageCull().intersectsLine(x0, y0, x1, y1)) return;
+      GxEPD2_GFX_BASE_CLASS::drawLine(x0, y0, x1, y1, color);
+    }
+
+    // bitmaps are drawn for the rows and columns on the current page only
+    using GxEPD2_GFX_BASE_CLASS::drawBitmap;
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, color, false, false, true);
+    }
+
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, bg, true, false, true);
+    }
+
+    void drawBitmap(int16_t x, int16_t y, uint8_t* bitmap, int16_t w, int16_t h, uint16_t color)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, color, false, false, false);
+    }
+
+    void drawBitmap(int16_t x, int16_t y, uint8_t* bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, bg, true, false, false);
+    }
+
+#if ENABLE_GxEPD2_TEXT_CULLING
+    // characters outside the current page are not drawn, the cursor advances and wraps as in Adafruit_GFX::write()
+    using GxEPD2_GFX_BASE_CLASS::write;
+    size_t write(uint8_t c)
+    {
+      int16_t cx = cursor_x, cy = cursor_y, bx, by, bw, bh;
+      if (!GxEPD2_PageCull::charBox(c, gfxFont, textsize_x, textsize_y, wrap, _width, cx, cy, bx, by, bw, bh)) return GxEPD2_GFX_BASE_CLASS::write(c);
+      if (_pageIntersects(bx, by, int32_t(bx) + bw, int32_t(by) + bh)) return GxEPD2_GFX_BASE_CLASS::write(c); // wraps the same way
+      cursor_x = cx;
+      cursor_y = cy;
+      return 1;
+    }
+#endif
+
+    void drawInvertedBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, color, false, true, true);
+    }
+
+    //  Support for Bitmaps (Sprites) to Controller Buffer and to Screen
+    void clearScreen(uint8_t value = 0xFF) // init controller memory and screen (default white)
+    {
+      epd2.clearScreen(value);
+    }
+    void writeScreenBuffer(uint8_t value = 0xFF) // init controller memory (default white)
+    {
+      epd2.writeScreenBuffer(value);
+    }
+    // write to controller memory, without screen refresh; x and w should be multiple of 8
+    void writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
+    {
+      epd2.writeImage(bitmap, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                        int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
+    {
+      epd2.writeImagePart(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+    {
+      epd2.writeImage(black, color, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      epd2.writeImage(black, color, x, y, w, h, false, false, false);
+    }
+    void writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                        int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+    {
+      epd2.writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                        int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      epd2.writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, false, false, false);
+    }
+    // write sprite of native data to controller memory, without screen refresh; x and w should be multiple of 8
+    void writeNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+    {
+      epd2.writeNative(data1, data2, x, y, w, h, invert, mirror_y, pgm);
+    }
+    // write to controller memory, with screen refresh; x and w should be multiple of 8
+    void drawImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
+    {
+      epd2.drawImage(bitmap, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void drawImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                       int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
+    {
+      epd2.drawImagePart(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+    {
+      epd2.drawImage(black, color, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      epd2.drawImage(black, color, x, y, w, h, false, false, false);
+    }
+    void drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                       int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+    {
+      epd2.drawImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                       int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      epd2.drawImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, false, false, false);
+    }
+    // write sprite of native data to controller memory, with screen refresh; x and w should be multiple of 8
+    void drawNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+    {
+      epd2.drawNative(data1, data2, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void refresh(bool partial_update_mode = false) // screen refresh from controller memory to full screen
+    {
+      epd2.refresh(partial_update_mode);
+      if (!partial_update_mode) epd2.powerOff();
+    }
+    void refresh(int16_t x, int16_t y, int16_t w, int16_t h) // screen refresh from controller memory, partial screen
+    {
+      epd2.refresh(x, y, w, h);
+    }
+    // turns off generation of panel driving voltages, avoids screen fading over time
+    void powerOff()
+    {
+      epd2.powerOff();
+    }
+    // turns powerOff() and sets controller to deep sleep for minimum power use, ONLY if wakeable by RST (rst >= 0)
+    void hibernate()
+    {
+      epd2.hibernate();
+    }
+  private:
+    template <typename T> static inline void
+    _swap_(T & a, T & b)
+    {
+      T t = a;
+      a = b;
+      b = t;
+    };
+    static inline uint16_t gx_uint16_min(uint16_t a, uint16_t b)
+    {
+      return (a < b ? a : b);
+    };
+    static inline uint16_t gx_uint16_max(uint16_t a, uint16_t b)
+    {
+      return (a > b ? a : b);
+    };
+    void _rotate(uint16_t& x, uint16_t& y, uint16_t& w, uint16_t& h)
+    {
+      switch (getRotation())
+      {
+        case 1:
+          _swap_(x, y);
+          _swap_(w, h);
+          x = WIDTH - x - w;
+          break;
+        case 2:
+          x = WIDTH - x - w;
+          y = HEIGHT - y - h;
+          break;
+        case 3:
+          _swap_(x, y);
+          _swap_(w, h);
+          y = HEIGHT - y - h;
+          break;
+      }
+    }
+    // inverse of _rotate(), from panel to drawing coordinates
+    void _unrotate(uint16_t& x, uint16_t& y, uint16_t& w, uint16_t& h)
+    {
+      switch (getRotation())
+      {
+        case 1:
+          _swap_(x, y);
+          _swap_(w, h);
+          y = WIDTH - y - h;
+          break;
+        case 2:
+          x = WIDTH - x - w;
+          y = HEIGHT - y - h;
+          break;
+        case 3:
+          _swap_(x, y);
+          _swap_(w, h);
+          x = HEIGHT - x - w;
+          break;
+      }
+    }
+    // true if x0 <= x < x1, y0 <= y < y1 in drawing coordinates intersects the current page
+    bool _pageIntersects(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+    {
+      return _pageCull().intersects(x0, y0, x1, y1);
+    }
+    GxEPD2_PageCull _pageCull()
+    {
+      int16_t x, y, w, h;
+      getPageBounds(x, y, w, h);
+      return GxEPD2_PageCull(x, y, w, h);
+    }
+    // draws the part of a bitmap on the current page, set bits with color, clear bits with bg if use_bg; invert swaps set and clear
+    void _drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg, bool use_bg, bool invert, bool pgm)
+    {
+      _pageCull().drawBitmap(*this, x, y, bitmap, w, h, color, bg, use_bg, invert, pgm);
+    }
+    // transforms a rectangle to the buffer of the current page, as drawPixel() does for a pixel
+    // result is the buffer window xs <= x < xe, ys <= y < ye, false if nothing is visible
+    bool _bufferRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t& xs, uint16_t& ys, uint16_t& xe, uint16_t& ye)
+    {
+      int32_t x0 = x, y0 = y, x1 = int32_t(x) + w, y1 = int32_t(y) + h;
+      if (w < 0) // negative width extends to the left, as in Adafruit_SPITFT
+      {
+        x0 = x1 + 1;
+        x1 = int32_t(x) + 1;
+      }
+      if (h < 0)
+      {
+        y0 = y1 + 1;
+        y1 = int32_t(y) + 1;
+      }
+      // clip to screen
+      if (x0 < 0) x0 = 0;
+      if (y0 < 0) y0 = 0;
+      if (x1 > width()) x1 = width();
+      if (y1 > height()) y1 = height();
+      if ((x0 >= x1) || (y0 >= y1)) return false;
+      uint16_t rx = x0, ry = y0, rw = x1 - x0, rh = y1 - y0;
+      if (_mirror) rx = width() - rx - rw;
+      _rotate(rx, ry, rw, rh);
+      // transpose partial window to 0,0 and clip
+      x0 = int32_t(rx) - _pw_x;
+      y0 = int32_t(ry) - _pw_y;
+      x1 = x0 + rw;
+      y1 = y0 + rh;
+      if (x0 < 0) x0 = 0;
+      if (y0 < 0) y0 = 0;
+      if (x1 > _pw_w) x1 = _pw_w;
+      if (y1 > _pw_h) y1 = _pw_h;
+      // adjust for current page and clip
+      y0 -= int32_t(_current_page) * _page_height;
+      y1 -= int32_t(_current_page) * _page_height;
+      if (y0 < 0) y0 = 0;
+      if (y1 > _page_height) y1 = _page_height;
+      if ((x0 >= x1) || (y0 >= y1)) return false;
+      xs = x0;
+      xe = x1;
+      ys = y0;
+      ye = y1;
+      return true;
+    }
+    // quantizes RGB565 to the nearest of 4 grey levels by luminance, 3 white, 0 black
+    static uint8_t grey4(uint16_t color)
+    {
+      uint16_t red = (color >> 8) & 0xF8, green = (color >> 3) & 0xFC, blue = (color << 3) & 0xF8;
+      uint8_t luminance = (red * 77 + green * 150 + blue * 29) >> 8;
+      return luminance < 43 ? 0 : luminance < 128 ? 1 : luminance < 213 ? 2 : 3;
+    }
+  private:
+    static const uint16_t _internal_rows = page_height > 0 ? page_height : 1;
+    uint8_t _internal_buffer[(GxEPD2_Type::WIDTH / 4) * _internal_rows];
+    uint8_t* _pixel_buffer;
+    GxEPD2_TransportBus<GxEPD2_Transport> _bus;
+    bool _using_partial_mode, _mirror;
+    int16_t _current_page;
+    uint16_t _pages, _page_height;
+    uint16_t _pw_x, _pw_y, _pw_w, _pw_h;
+};
+
+#endif
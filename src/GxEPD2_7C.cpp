@@ -0,0 +1,145 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// quantization table for GxEPD2_7C::color7(), RGB565 reduced to 4 bits per channel, index r4 g4 b4, two codes per byte, high nibble first
+// codes 0..6 are black, white, green, blue, red, yellow, orange; code 7 marks a cell on a decision boundary, resolved with full precision
+
+#include <Arduino.h>
+
+extern const uint8_t GxEPD2_color7_lut[2048] PROGMEM =
+{
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x33, 0x33, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x33, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x33, 0x33, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x33, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x33, 0x33, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x33, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x33, 0x33, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x33, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x33, 0x33, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x33, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x33, 0x33, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x33, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x33, 0x33, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x33, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x33, 0x33, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x33, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x33, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27, 0x33,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x73, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x27,
+  0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x33, 0x33, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x33, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x33, 0x33, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x33, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x33, 0x33, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x33, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x33, 0x33, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x33, 0x33,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x77, 0x77, 0x77, 0x77, 0x11, 0x11, 0x11, 0x11,
+  0x55, 0x55, 0x55, 0x55, 0x11, 0x11, 0x11, 0x11, 0x55, 0x55, 0x55, 0x55, 0x11, 0x11, 0x11, 0x11,
+  0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x33, 0x33, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x33, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x33, 0x33, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x33, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x33, 0x33, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x33, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x33, 0x33, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x33, 0x33,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x77, 0x77, 0x77, 0x77, 0x11, 0x11, 0x11, 0x11,
+  0x55, 0x55, 0x55, 0x55, 0x11, 0x11, 0x11, 0x11, 0x55, 0x55, 0x55, 0x55, 0x11, 0x11, 0x11, 0x11,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x33, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x33, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x33, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x33, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x33,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x77, 0x77, 0x77, 0x77, 0x11, 0x11, 0x11, 0x11,
+  0x55, 0x55, 0x55, 0x55, 0x11, 0x11, 0x11, 0x11, 0x55, 0x55, 0x55, 0x55, 0x11, 0x11, 0x11, 0x11,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x33, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x33, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x33, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x33, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x33,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x77, 0x77, 0x77, 0x77, 0x11, 0x11, 0x11, 0x11,
+  0x55, 0x55, 0x55, 0x55, 0x11, 0x11, 0x11, 0x11, 0x55, 0x55, 0x55, 0x55, 0x11, 0x11, 0x11, 0x11,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x33,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x77, 0x77, 0x77, 0x77, 0x11, 0x11, 0x11, 0x11,
+  0x55, 0x55, 0x55, 0x55, 0x11, 0x11, 0x11, 0x11, 0x55, 0x55, 0x55, 0x55, 0x11, 0x11, 0x11, 0x11,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x33,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x77, 0x77, 0x77, 0x77, 0x11, 0x11, 0x11, 0x11,
+  0x55, 0x55, 0x55, 0x55, 0x11, 0x11, 0x11, 0x11, 0x55, 0x55, 0x55, 0x55, 0x11, 0x11, 0x11, 0x11,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x73,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x77, 0x77, 0x77, 0x77, 0x11, 0x11, 0x11, 0x11,
+  0x55, 0x55, 0x55, 0x55, 0x11, 0x11, 0x11, 0x11, 0x55, 0x55, 0x55, 0x55, 0x11, 0x11, 0x11, 0x11,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47,
+  0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x47,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11,
+  0x66, 0x66, 0x66, 0x66, 0x11, 0x11, 0x11, 0x11, 0x77, 0x77, 0x77, 0x77, 0x11, 0x11, 0x11, 0x11,
+  0x55, 0x55, 0x55, 0x55, 0x11, 0x11, 0x11, 0x11, 0x55, 0x55, 0x55, 0x55, 0x11, 0x11, 0x11, 0x11
+};
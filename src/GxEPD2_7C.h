@@ -30,26 +30,36 @@
 #endif
 
 #include "GxEPD2_EPD.h"
+#include "GxEPD2_PageCull.h"
 #include "epd3c/GxEPD2_565c.h"
 
-template<typename GxEPD2_Type, const uint16_t page_height>
+extern const uint8_t GxEPD2_color7_lut[2048] PROGMEM; // see GxEPD2_7C.cpp
+
+// GxEPD2_Transport : bus transport, see GxEPD2_Transport.h
+template<typename GxEPD2_Type, const uint16_t page_height, typename GxEPD2_Transport = GxEPD2_HwSpi>
 class GxEPD2_7C : public GxEPD2_GFX_BASE_CLASS
 {
   public:
     GxEPD2_Type epd2;
+    // buffer, size : optional page buffer, see setBuffer()
 #if ENABLE_GxEPD2_GFX
-    GxEPD2_7C(GxEPD2_Type epd2_instance) : GxEPD2_GFX_BASE_CLASS(epd2, GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
+    GxEPD2_7C(GxEPD2_Type epd2_instance, uint8_t* buffer = 0, uint32_t size = 0) : GxEPD2_GFX_BASE_CLASS(epd2, GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
 #else
-    GxEPD2_7C(GxEPD2_Type epd2_instance) : GxEPD2_GFX_BASE_CLASS(GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
+    GxEPD2_7C(GxEPD2_Type epd2_instance, uint8_t* buffer = 0, uint32_t size = 0) : GxEPD2_GFX_BASE_CLASS(GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
 #endif
     {
-      _page_height = page_height;
-      _pages = (HEIGHT / _page_height) + ((HEIGHT % _page_height) > 0);
       _mirror = false;
       _using_partial_mode = false;
       _current_page = 0;
+      epd2.setBus(_bus);
+      setBuffer(buffer, size);
       setFullWindow();
     }
+    // the transport of epd2, e.g. display.transport().setPins(sck, mosi); for GxEPD2_SwSpi
+    GxEPD2_Transport& transport()
+    {
+      return _bus.transport;
+    };
 
     uint16_t pages()
     {
@@ -102,6 +112,39 @@ class GxEPD2_7C : public GxEPD2_GFX_BASE_CLASS
       else _pixel_buffer[i] = (_pixel_buffer[i] & 0x0F) | (pv << 4);
     }
 
+    // span kernels: the transform and color quantization are done once per primitive, rows are filled with packed pixel pairs
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+    {
+      fillRect(x, y, w, 1, color);
+    }
+
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+    {
+      fillRect(x, y, 1, h, color);
+    }
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      uint16_t xs, ys, xe, ye;
+      if (!_bufferRect(x, y, w, h, xs, ys, xe, ye)) return;
+      uint8_t pv = color7(color);
+      uint8_t pv2 = pv | pv << 4;
+      uint16_t row_bytes = _pw_w / 2;
+      if ((xs == 0) && (xe == _pw_w)) memset(_pixel_buffer + uint32_t(ys) * row_bytes, pv2, uint32_t(ye - ys) * row_bytes); // whole rows
+      else for (uint16_t y1 = ys; y1 < ye; y1++)
+      {
+        uint8_t* row = _pixel_buffer + uint32_t(y1) * row_bytes;
+        uint16_t x1 = xs;
+        if (x1 & 1) // odd start, low nibble
+        {
+          row[x1 / 2] = (row[x1 / 2] & 0xF0) | pv;
+          x1++;
+        }
+        if (xe > x1) memset(row + x1 / 2, pv2, (xe - x1) / 2);
+        if ((xe > x1) && (xe & 1)) row[xe / 2] = (row[xe / 2] & 0x0F) | (pv << 4); // odd end, high nibble
+      }
+    }
+
     void init(uint32_t serial_diag_bitrate = 0) // = 0 : disabled
     {
       epd2.init(serial_diag_bitrate);
@@ -127,10 +170,7 @@ class GxEPD2_7C : public GxEPD2_GFX_BASE_CLASS
     {
       uint8_t pv = color7(color);
       uint8_t pv2 = pv | pv << 4;
-      for (uint32_t x = 0; x < sizeof(_pixel_buffer); x++)
-      {
-        _pixel_buffer[x] = pv2;
-      }
+      memset(_pixel_buffer, pv2, uint32_t(_page_height) * (WIDTH / 2));
     }
 
     // display buffer content to screen, useful for full screen buffer
@@ -141,6 +181,19 @@ class GxEPD2_7C : public GxEPD2_GFX_BASE_CLASS
       if (!partial_update_mode) epd2.powerOff();
     }
 
+    // asynchronous display(): returns while the screen refreshes, call poll() until it returns false
+    void displayAsync(bool partial_update_mode = false)
+    {
+      epd2.writeNative(_pixel_buffer, 0, 0, 0, WIDTH, _page_height);
+      epd2.refreshAsync(partial_update_mode, partial_update_mode ? GxEPD2_EPD::AsyncNone : GxEPD2_EPD::AsyncPowerOff);
+    }
+
+    // advances asynchronous display, returns true while in progress
+    bool poll()
+    {
+      return epd2.poll();
+    }
+
     // display part of buffer content to screen, useful for full screen buffer
     // displayWindow, use parameters according to actual rotation.
     // x and w should be multiple of 8, for rotation 0 or 2,
@@ -187,6 +240,18 @@ class GxEPD2_7C : public GxEPD2_GFX_BASE_CLASS
       _pw_x -= _pw_x % 2;
     }
 
+    // page buffer in caller supplied memory of any size, e.g. PSRAM on ESP32 or a scratch area shared with other code,
+    // instead of the buffer of page_height rows in the class; the page height is as many rows as fit, up to HEIGHT;
+    // buffer 0 returns to the internal buffer; use page_height 0 for an internal buffer of only 1 row
+    void setBuffer(uint8_t* buffer, uint32_t size)
+    {
+      uint32_t rows = buffer ? size / (GxEPD2_Type::WIDTH / 2) : 0;
+      _pixel_buffer = rows ? buffer : _internal_buffer;
+      _page_height = rows ? (rows < GxEPD2_Type::HEIGHT ? rows : GxEPD2_Type::HEIGHT) : _internal_rows;
+      _pages = (HEIGHT / _page_height) + ((HEIGHT % _page_height) > 0);
+      _current_page = 0;
+    }
+
     void firstPage()
     {
       fillScreen(GxEPD_WHITE);
@@ -297,30 +362,73 @@ class GxEPD2_7C : public GxEPD2_GFX_BASE_CLASS
       _current_page = 0;
     }
 
-    void drawInvertedBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+    // bounds of the current page in drawing coordinates, according to rotation, mirror and partial window;
+    // only pixels inside go to the buffer, e.g. drawPaged() callbacks can skip whole widgets outside, see pageIntersects()
+    void getPageBounds(int16_t& x, int16_t& y, int16_t& w, int16_t& h)
+    {
+      uint16_t ys = gx_uint16_min(_current_page * _page_height, _pw_h);
+      uint16_t px = _pw_x, py = _pw_y + ys, pw = _pw_w, ph = gx_uint16_min(_page_height, _pw_h - ys);
+      _unrotate(px, py, pw, ph);
+      if (_mirror) px = width() - px - pw;
+      x = px;
+      y = py;
+      w = pw;
+      h = ph;
+    }
+
+    // true if the rectangle is (partly) on the current page
+    bool pageIntersects(int16_t x, int16_t y, int16_t w, int16_t h)
     {
-      // taken from Adafruit_GFX.cpp, modified
-      int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-      uint8_t byte = 0;
-      for (int16_t j = 0; j < h; j++)
-      {
-        for (int16_t i = 0; i < w; i++ )
-        {
-          if (i & 7) byte <<= 1;
-          else
-          {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-            byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-#else
-            byte = bitmap[j * byteWidth + i / 8];
+      if ((w <= 0) || (h <= 0)) return false;
+      return _pageIntersects(x, y, int32_t(x) + w, int32_t(y) + h);
+    }
+
+    // page culling, see GxEPD2_PageCull.h: lines outside the current page are skipped
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+    {
+      if (!_pageCull().intersectsLine(x0, y0, x1, y1)) return;
+      GxEPD2_GFX_BASE_CLASS::drawLine(x0, y0, x1, y1, color);
+    }
+
+    // bitmaps are drawn for the rows and columns on the current page only
+    using GxEPD2_GFX_BASE_CLASS::drawBitmap;
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, color, false, false, true);
+    }
+
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, bg, true, false, true);
+    }
+
+    void drawBitmap(int16_t x, int16_t y, uint8_t* bitmap, int16_t w, int16_t h, uint16_t color)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, color, false, false, false);
+    }
+
+    void drawBitmap(int16_t x, int16_t y, uint8_t* bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, bg, true, false, false);
+    }
+
+#if ENABLE_GxEPD2_TEXT_CULLING
+    // characters outside the current page are not drawn, the cursor advances and wraps as in Adafruit_GFX::write()
+    using GxEPD2_GFX_BASE_CLASS::write;
+    size_t write(uint8_t c)
+    {
+      int16_t cx = cursor_x, cy = cursor_y, bx, by, bw, bh;
+      if (!GxEPD2_PageCull::charBox(c, gfxFont, textsize_x, textsize_y, wrap, _width, cx, cy, bx, by, bw, bh)) return GxEPD2_GFX_BASE_CLASS::write(c);
+      if (_pageIntersects(bx, by, int32_t(bx) + bw, int32_t(by) + bh)) return GxEPD2_GFX_BASE_CLASS::write(c); // wraps the same way
+      cursor_x = cx;
+      cursor_y = cy;
+      return 1;
+    }
 #endif
-          }
-          if (!(byte & 0x80))
-          {
-            drawPixel(x + i, y + j, color);
-          }
-        }
-      }
+
+    void drawInvertedBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, color, false, true, true);
     }
 
     //  Support for Bitmaps (Sprites) to Controller Buffer and to Screen
@@ -453,46 +561,112 @@ class GxEPD2_7C : public GxEPD2_GFX_BASE_CLASS
           break;
       }
     }
-    uint8_t color7(uint16_t color)
+    // inverse of _rotate(), from panel to drawing coordinates
+    void _unrotate(uint16_t& x, uint16_t& y, uint16_t& w, uint16_t& h)
     {
-      static uint16_t _prev_color = GxEPD_BLACK;
-      static uint8_t _prev_color7 = 0x00; // black
-      if (color == _prev_color) return _prev_color7;
-      uint8_t cv7 = 0x00;
-      switch (color)
+      switch (getRotation())
       {
-        case GxEPD_BLACK: cv7 = 0x00; break;
-        case GxEPD_WHITE: cv7 = 0x01; break;
-        case GxEPD_GREEN: cv7 = 0x02; break;
-        case GxEPD_BLUE:  cv7 = 0x03; break;
-        case GxEPD_RED:   cv7 = 0x04; break;
-        case GxEPD_YELLOW: cv7 = 0x05; break;
-        case GxEPD_ORANGE: cv7 = 0x06; break;
-        default:
-          {
-            uint16_t red = color & 0xF800;
-            uint16_t green = (color & 0x07E0) << 5;
-            uint16_t blue = (color & 0x001F) << 11;
-            if ((red < 0x8000) && (green < 0x8000) && (blue < 0x8000)) cv7 = 0x00; // black
-            else if ((red >= 0x8000) && (green >= 0x8000) && (blue >= 0x8000)) cv7 = 0x01; // white
-            else if ((red >= 0x8000) && (blue >= 0x8000)) cv7 = red > blue ? 0x04 : 0x03; // red, blue
-            else if ((green >= 0x8000) && (blue >= 0x8000)) cv7 = green > blue ? 0x02 : 0x03; // green, blue
-            else if ((red >= 0x8000) && (green >= 0x8000))
-            {
-              static const uint16_t y2o_lim = ((GxEPD_YELLOW - GxEPD_ORANGE) / 2 + (GxEPD_ORANGE & 0x07E0)) << 5;
-              cv7 = green > y2o_lim ? 0x05 : 0x06; // yellow, orange
-            }
-            else if (red >= 0x8000) cv7 = 0x04; // red
-            else if (green >= 0x8000) cv7 = 0x02; // green
-            else cv7 = 0x03; // blue
-          }
+        case 1:
+          _swap_(x, y);
+          _swap_(w, h);
+          y = WIDTH - y - h;
+          break;
+        case 2:
+          x = WIDTH - x - w;
+          y = HEIGHT - y - h;
+          break;
+        case 3:
+          _swap_(x, y);
+          _swap_(w, h);
+          x = HEIGHT - x - w;
+          break;
+      }
+    }
+    // true if x0 <= x < x1, y0 <= y < y1 in drawing coordinates intersects the current page
+    bool _pageIntersects(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+    {
+      return _pageCull().intersects(x0, y0, x1, y1);
+    }
+    GxEPD2_PageCull _pageCull()
+    {
+      int16_t x, y, w, h;
+      getPageBounds(x, y, w, h);
+      return GxEPD2_PageCull(x, y, w, h);
+    }
+    // draws the part of a bitmap on the current page, set bits with color, clear bits with bg if use_bg; invert swaps set and clear
+    void _drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg, bool use_bg, bool invert, bool pgm)
+    {
+      _pageCull().drawBitmap(*this, x, y, bitmap, w, h, color, bg, use_bg, invert, pgm);
+    }
+    // transforms a rectangle to the buffer of the current page, as drawPixel() does for a pixel
+    // result is the buffer window xs <= x < xe, ys <= y < ye, false if nothing is visible
+    bool _bufferRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t& xs, uint16_t& ys, uint16_t& xe, uint16_t& ye)
+    {
+      int32_t x0 = x, y0 = y, x1 = int32_t(x) + w, y1 = int32_t(y) + h;
+      if (w < 0) // negative width extends to the left, as in Adafruit_SPITFT
+      {
+        x0 = x1 + 1;
+        x1 = int32_t(x) + 1;
+      }
+      if (h < 0)
+      {
+        y0 = y1 + 1;
+        y1 = int32_t(y) + 1;
+      }
+      // clip to screen
+      if (x0 < 0) x0 = 0;
+      if (y0 < 0) y0 = 0;
+      if (x1 > width()) x1 = width();
+      if (y1 > height()) y1 = height();
+      if ((x0 >= x1) || (y0 >= y1)) return false;
+      uint16_t rx = x0, ry = y0, rw = x1 - x0, rh = y1 - y0;
+      if (_mirror) rx = width() - rx - rw;
+      _rotate(rx, ry, rw, rh);
+      // transpose partial window to 0,0 and clip
+      x0 = int32_t(rx) - _pw_x;
+      y0 = int32_t(ry) - _pw_y;
+      x1 = x0 + rw;
+      y1 = y0 + rh;
+      if (x0 < 0) x0 = 0;
+      if (y0 < 0) y0 = 0;
+      if (x1 > _pw_w) x1 = _pw_w;
+      if (y1 > _pw_h) y1 = _pw_h;
+      // adjust for current page and clip
+      y0 -= int32_t(_current_page) * _page_height;
+      y1 -= int32_t(_current_page) * _page_height;
+      if (y0 < 0) y0 = 0;
+      if (y1 > _page_height) y1 = _page_height;
+      if ((x0 >= x1) || (y0 >= y1)) return false;
+      xs = x0;
+      xe = x1;
+      ys = y0;
+      ye = y1;
+      return true;
+    }
+    // quantizes RGB565 to the panel colors by table lookup, no state, cells on a decision boundary are resolved with full precision
+    static uint8_t color7(uint16_t color)
+    {
+      uint16_t i = ((color >> 4) & 0x0F00) | ((color >> 3) & 0x00F0) | ((color >> 1) & 0x000F);
+      uint8_t cv7 = pgm_read_byte(&GxEPD2_color7_lut[i / 2]);
+      cv7 = (i & 1) ? cv7 & 0x0F : cv7 >> 4;
+      if (cv7 < 0x07) return cv7;
+      // two channels high, compare them
+      uint16_t red = color & 0xF800;
+      uint16_t green = (color & 0x07E0) << 5;
+      uint16_t blue = (color & 0x001F) << 11;
+      if (blue < 0x8000)
+      {
+        static const uint16_t y2o_lim = ((GxEPD_YELLOW - GxEPD_ORANGE) / 2 + (GxEPD_ORANGE & 0x07E0)) << 5;
+        return green > y2o_lim ? 0x05 : 0x06; // yellow, orange
       }
-      _prev_color = color;
-      _prev_color7 = cv7;
-      return cv7;
+      if (red >= 0x8000) return red > blue ? 0x04 : 0x03; // red, blue
+      return green > blue ? 0x02 : 0x03; // green, blue
     }
   private:
-    uint8_t _pixel_buffer[(GxEPD2_Type::WIDTH / 2) * page_height];
+    static const uint16_t _internal_rows = page_height > 0 ? page_height : 1;
+    uint8_t _internal_buffer[(GxEPD2_Type::WIDTH / 2) * _internal_rows];
+    uint8_t* _pixel_buffer;
+    GxEPD2_TransportBus<GxEPD2_Transport> _bus;
     bool _using_partial_mode, _second_phase, _mirror;
     uint16_t _width_bytes, _pixel_bytes;
     int16_t _current_page;
@@ -30,7 +30,27 @@
 #define GxEPD2_GFX_BASE_CLASS Adafruit_GFX
 #endif
 
+#ifndef GxEPD2_GFX_ROOT_CLASS
+#define GxEPD2_GFX_ROOT_CLASS GxEPD2_GFX_BASE_CLASS
+#endif
+
 #include "GxEPD2_EPD.h"
+#include "GxEPD2_RLE.h"
+#include "GxEPD2_PageWriter.h"
+#include "GxEPD2_PageCull.h"
+#include "GxEPD2_Band.h"
+#include "GxEPD2_RowHash.h"
+
+// tracking of the rectangles changed by drawing, for displayDirty(), full screen buffer only
+#ifndef ENABLE_GxEPD2_DIRTY_BOXES
+// default is off, compiles out; displayDirty() is display(true) then
+#define ENABLE_GxEPD2_DIRTY_BOXES 0
+#endif
+
+// number of rectangles tracked for displayDirty()
+#ifndef GxEPD2_DIRTY_BOXES
+#define GxEPD2_DIRTY_BOXES 4
+#endif
 #include "epd/GxEPD2_154.h"
 #include "epd/GxEPD2_154_D67.h"
 #include "epd/GxEPD2_154_T8.h"
@@ -59,25 +79,43 @@
 #include "it8951/GxEPD2_it60.h"
 #include "it8951/GxEPD2_it60_1448x1072.h"
 
-template<typename GxEPD2_Type, const uint16_t page_height>
+// GxEPD2_Transport : bus transport, see GxEPD2_Transport.h
+template<typename GxEPD2_Type, const uint16_t page_height, typename GxEPD2_Transport = GxEPD2_HwSpi>
 class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
 {
   public:
     GxEPD2_Type epd2;
+    // buffer, size : optional page buffer, see setBuffer()
 #if ENABLE_GxEPD2_GFX
-    GxEPD2_BW(GxEPD2_Type epd2_instance) : GxEPD2_GFX_BASE_CLASS(epd2, GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
+    GxEPD2_BW(GxEPD2_Type epd2_instance, uint8_t* buffer = 0, uint32_t size = 0) : GxEPD2_GFX_BASE_CLASS(epd2, GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
 #else
-    GxEPD2_BW(GxEPD2_Type epd2_instance) : GxEPD2_GFX_BASE_CLASS(GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
+    GxEPD2_BW(GxEPD2_Type epd2_instance, uint8_t* buffer = 0, uint32_t size = 0) : GxEPD2_GFX_BASE_CLASS(GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
 #endif
     {
-      _page_height = page_height;
-      _pages = (HEIGHT / _page_height) + ((HEIGHT % _page_height) > 0);
       _reverse = (epd2_instance.panel == GxEPD2::GDE0213B1);
       _mirror = false;
       _using_partial_mode = false;
       _current_page = 0;
+      _dirty_count = 0;
+      _dirty_last = 0;
+      _page_store = 0;
+      _page_store_size = 0;
+      _page_store_ok = false;
+      _page_writer = 0;
+      _drawing_bands = false;
+      _back_buffer = 0;
+      _back_buffer_size = 0;
+      _buffers_swapped = false;
+      _invalidateRowHashes();
+      epd2.setBus(_bus);
+      setBuffer(buffer, size);
       setFullWindow();
     }
+    // the transport of epd2, e.g. display.transport().setPins(sck, mosi); for GxEPD2_SwSpi
+    GxEPD2_Transport& transport()
+    {
+      return _bus.transport;
+    };
 
     uint16_t pages()
     {
@@ -97,43 +135,31 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
 
     void drawPixel(int16_t x, int16_t y, uint16_t color)
     {
-      if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return;
-      if (_mirror) x = width() - x - 1;
-      // check rotation, move pixel around if necessary
-      switch (getRotation())
-      {
-        case 1:
-          _swap_(x, y);
-          x = WIDTH - x - 1;
-          break;
-        case 2:
-          x = WIDTH - x - 1;
-          y = HEIGHT - y - 1;
-          break;
-        case 3:
-          _swap_(x, y);
-          y = HEIGHT - y - 1;
-          break;
-      }
-      // transpose partial window to 0,0
-      x -= _pw_x;
-      y -= _pw_y;
-      // clip to (partial) window
-      if ((x < 0) || (x >= _pw_w) || (y < 0) || (y >= _pw_h)) return;
-      // adjust for current page
-      y -= _current_page * _page_height;
-      if (_reverse) y = _page_height - y - 1;
-      // check if in current page
-      if ((y < 0) || (y >= _page_height)) return;
-      uint16_t i = x / 8 + y * (_pw_w / 8);
-      if (color)
-        _buffer[i] = (_buffer[i] | (1 << (7 - x % 8)));
-      else
-        _buffer[i] = (_buffer[i] & (0xFF ^ (1 << (7 - x % 8))));
+      _drawPixel(x, y, color, 0, _page_height);
+    }
+
+    // span kernels: the transform is done once per primitive, rows are filled bytewise with edge masks
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+    {
+      fillRect(x, y, w, 1, color);
+    }
+
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+    {
+      fillRect(x, y, 1, h, color);
+    }
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      uint16_t xs, ys, xe, ye;
+      if (!_bufferRect(x, y, w, h, xs, ys, xe, ye)) return;
+      _markDirty(xs + _pw_x, (_reverse ? _page_height - ye : ys) + _pw_y, xe - xs, ye - ys);
+      _fillBuffer(xs, ys, xe, ye, color);
     }
 
     void init(uint32_t serial_diag_bitrate = 0) // = 0 : disabled
     {
+      _invalidateRowHashes();
       epd2.init(serial_diag_bitrate);
       _using_partial_mode = false;
       _current_page = 0;
@@ -148,6 +174,7 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
     // pulldown_rst_mode true for alternate RST handling to avoid feeding 5V through RST pin
     void init(uint32_t serial_diag_bitrate, bool initial, uint16_t reset_duration = 20, bool pulldown_rst_mode = false)
     {
+      _invalidateRowHashes();
       epd2.init(serial_diag_bitrate, initial, reset_duration, pulldown_rst_mode);
       _using_partial_mode = false;
       _current_page = 0;
@@ -157,15 +184,22 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
     void fillScreen(uint16_t color) // 0x0 black, >0x0 white, to buffer
     {
       uint8_t data = (color == GxEPD_BLACK) ? 0x00 : 0xFF;
-      for (uint16_t x = 0; x < sizeof(_buffer); x++)
-      {
-        _buffer[x] = data;
-      }
+      memset(_buffer, data, uint32_t(_page_height) * (WIDTH / 8));
+      _markDirty(_pw_x, _pw_y, _pw_w, _pw_h);
     }
 
     // display buffer content to screen, useful for full screen buffer
     void display(bool partial_update_mode = false)
     {
+      if (_rowsUnchanged()) return;
+#if ENABLE_GxEPD2_ROW_HASH
+      if (partial_update_mode && (_page_height >= GxEPD2_Type::HEIGHT))
+      {
+        _row_hash.displayChanged(*this, _reverse);
+        _dirty_count = 0;
+        return;
+      }
+#endif
       if (partial_update_mode) epd2.writeImage(_buffer, 0, 0, WIDTH, _page_height);
       else epd2.writeImageForFullRefresh(_buffer, 0, 0, WIDTH, _page_height);
       epd2.refresh(partial_update_mode);
@@ -174,6 +208,28 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
         epd2.writeImageAgain(_buffer, 0, 0, WIDTH, _page_height);
       }
       if (!partial_update_mode) epd2.powerOff();
+      _dirty_count = 0;
+    }
+
+    // asynchronous display(): returns while the screen refreshes, call poll() until it returns false
+    // buffer content must be kept unchanged until done, for the second phase write on fast partial update displays
+    void displayAsync(bool partial_update_mode = false)
+    {
+      if (_rowsUnchanged()) return;
+      if (partial_update_mode) epd2.writeImage(_buffer, 0, 0, WIDTH, _page_height);
+      else epd2.writeImageForFullRefresh(_buffer, 0, 0, WIDTH, _page_height);
+      epd2.refreshAsync(partial_update_mode, partial_update_mode ? GxEPD2_EPD::AsyncNone : GxEPD2_EPD::AsyncPowerOff);
+      if (epd2.hasFastPartialUpdate)
+      {
+        epd2.writeImageAgainAsync(_buffer, 0, 0, WIDTH, _page_height);
+      }
+      _dirty_count = 0;
+    }
+
+    // advances asynchronous display, returns true while in progress
+    bool poll()
+    {
+      return epd2.poll();
     }
 
     // display part of buffer content to screen, useful for full screen buffer
@@ -184,6 +240,7 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
     // this is an addressing limitation of the e-paper controllers
     void displayWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
     {
+      _invalidateRowHashes();
       x = gx_uint16_min(x, width());
       y = gx_uint16_min(y, height());
       w = gx_uint16_min(w, width() - x);
@@ -198,8 +255,42 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
       }
     }
 
+    // display only the parts of the buffer changed by drawing since the last display, with partial refresh
+    // for full screen buffer, with ENABLE_GxEPD2_DIRTY_BOXES; the controller must hold the previous content, e.g. after display()
+    // the changed rectangles are written, then their bounding box is refreshed; in a partial window, from the window buffer
+    void displayDirty()
+    {
+#if ENABLE_GxEPD2_DIRTY_BOXES
+      _invalidateRowHashes();
+      if (0 == _dirty_count) return;
+      uint16_t xs = WIDTH, ys = HEIGHT, xe = 0, ye = 0;
+      for (uint8_t i = 0; i < _dirty_count; i++)
+      {
+        const GxEPD2_DirtyBox& b = _dirty[i];
+        epd2.writeImagePart(_buffer, b.xs - _pw_x, _dirtyRow(b), _pw_w, _page_height, b.xs, b.ys, b.xe - b.xs, b.ye - b.ys);
+        xs = gx_uint16_min(xs, b.xs);
+        ys = gx_uint16_min(ys, b.ys);
+        xe = gx_uint16_max(xe, b.xe);
+        ye = gx_uint16_max(ye, b.ye);
+      }
+      epd2.refresh(xs, ys, xe - xs, ye - ys);
+      if (epd2.hasFastPartialUpdate)
+      {
+        for (uint8_t i = 0; i < _dirty_count; i++)
+        {
+          const GxEPD2_DirtyBox& b = _dirty[i];
+          epd2.writeImagePartAgain(_buffer, b.xs - _pw_x, _dirtyRow(b), _pw_w, _page_height, b.xs, b.ys, b.xe - b.xs, b.ye - b.ys);
+        }
+      }
+      _dirty_count = 0;
+#else
+      display(true);
+#endif
+    }
+
     void setFullWindow()
     {
+      _dirty_count = 0; // the buffer layout changes
       _using_partial_mode = false;
       _pw_x = 0;
       _pw_y = 0;
@@ -219,6 +310,7 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
       _pw_w = gx_uint16_min(w, width() - _pw_x);
       _pw_h = gx_uint16_min(h, height() - _pw_y);
       _rotate(_pw_x, _pw_y, _pw_w, _pw_h);
+      _dirty_count = 0; // the buffer layout changes
       _using_partial_mode = true;
       // make _pw_x, _pw_w multiple of 8
       _pw_w += _pw_x % 8;
@@ -226,8 +318,48 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
       _pw_x -= _pw_x % 8;
     }
 
+    // caller supplied memory for run length encoded copies of the pages of the first phase of paged drawing;
+    // on fast partial update panels nextPage() and drawPaged() then write the second phase from these copies,
+    // without drawing again, if all pages fit; else drawing runs twice as before; 0 to disable
+    void setPageStore(uint8_t* store, uint32_t size)
+    {
+      _page_store = store;
+      _page_store_size = store ? size : 0;
+      _page_store_ok = false;
+    }
+
+    // page buffer in caller supplied memory of any size, e.g. PSRAM on ESP32 or a scratch area shared with other code,
+    // instead of the buffer of page_height rows in the class; the page height is as many rows as fit, up to HEIGHT;
+    // buffer 0 returns to the internal buffer; use page_height 0 for an internal buffer of only 1 row
+    void setBuffer(uint8_t* buffer, uint32_t size)
+    {
+      _waitPages();
+      uint32_t rows = buffer ? size / (GxEPD2_Type::WIDTH / 8) : 0;
+      _buffer = rows ? buffer : _internal_buffer;
+      _page_height = rows ? (rows < GxEPD2_Type::HEIGHT ? rows : GxEPD2_Type::HEIGHT) : _internal_rows;
+      _pages = (HEIGHT / _page_height) + ((HEIGHT % _page_height) > 0);
+      if (_back_buffer_size < uint32_t(_page_height) * (WIDTH / 8)) _page_writer = 0;
+      _current_page = 0;
+      _dirty_count = 0;
+      _page_store_ok = false;
+      _invalidateRowHashes();
+    }
+
+    // double buffered paged drawing: nextPage() and drawPaged() hand the page buffer to writer for the transfer to the controller,
+    // and continue with the second page buffer, of at least the size of the page buffer, so the next page is drawn during the transfer;
+    // e.g. with GxEPD2_TaskPageWriter on ESP32; writer 0 to disable
+    void setPageWriter(GxEPD2_PageWriter* writer, uint8_t* buffer, uint32_t size)
+    {
+      _waitPages();
+      bool fits = buffer && (size >= uint32_t(_page_height) * (WIDTH / 8));
+      _page_writer = fits ? writer : 0;
+      _back_buffer = fits ? buffer : 0;
+      _back_buffer_size = fits ? size : 0;
+    }
+
     void firstPage()
     {
+      _waitPages();
       fillScreen(GxEPD_WHITE);
       _current_page = 0;
       _second_phase = false;
@@ -239,6 +371,7 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
       {
         if (_using_partial_mode)
         {
+          _invalidateRowHashes();
           uint32_t offset = _reverse ? (HEIGHT - _pw_h) * _pw_w / 8 : 0;
           epd2.writeImage(_buffer + offset, _pw_x, _pw_y, _pw_w, _pw_h);
           epd2.refresh(_pw_x, _pw_y, _pw_w, _pw_h);
@@ -250,6 +383,7 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
         }
         else // full update
         {
+          if (_rowsUnchanged()) return false;
           epd2.writeImageForFullRefresh(_buffer, 0, 0, WIDTH, HEIGHT);
           epd2.refresh(false);
           if (epd2.hasFastPartialUpdate)
@@ -259,11 +393,13 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
           }
           epd2.powerOff();
         }
+        _dirty_count = 0;
         return false;
       }
       uint16_t page_ys = _current_page * _page_height;
       if (_using_partial_mode)
       {
+        _invalidateRowHashes();
         //Serial.print("  nextPage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(_pw_y); Serial.print(", ");
         //Serial.print(_pw_w); Serial.print(", "); Serial.print(_pw_h); Serial.print(") P"); Serial.println(_current_page);
         uint16_t page_ye = _current_page < (_pages - 1) ? page_ys + _page_height : HEIGHT;
@@ -274,24 +410,31 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
           //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
           //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.println(")");
           uint32_t offset = _reverse ? (_page_height - (dest_ye - dest_ys)) * _pw_w / 8 : 0;
-          if (!_second_phase) epd2.writeImage(_buffer + offset, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
-          else epd2.writeImageAgain(_buffer + offset, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
+          if (!_second_phase) _storePage();
+          _writePage(_second_phase ? _WriteImageAgain : _WriteImage, offset, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
         }
         else
         {
           //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
           //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.print(") skipped ");
           //Serial.print(dest_ys); Serial.print(".."); Serial.println(dest_ye);
+          if (!_second_phase) _storePage();
         }
         _current_page++;
         if (_current_page == _pages)
         {
+          _waitPages();
           _current_page = 0;
           if (!_second_phase)
           {
             epd2.refresh(_pw_x, _pw_y, _pw_w, _pw_h);
             if (epd2.hasFastPartialUpdate)
             {
+              if (_page_store_ok)
+              {
+                _writeStoredPages(); // second phase without drawing again
+                return false;
+              }
               _second_phase = true;
               fillScreen(GxEPD_WHITE);
               return true;
@@ -304,20 +447,34 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
       }
       else // full update
       {
-        if (!_second_phase) epd2.writeImageForFullRefresh(_buffer, 0, page_ys, WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
-        else epd2.writeImageAgain(_buffer, 0, page_ys, WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+        uint16_t page_rows = gx_uint16_min(_page_height, HEIGHT - page_ys);
+        bool write = true;
+#if ENABLE_GxEPD2_ROW_HASH
+        // pages the same as in the last frame sent are not written, the controller still has them
+        write = _second_phase ? _row_hash.changed(page_ys, page_ys + page_rows) : _row_hash.hashRows(page_ys, page_ys + page_rows, _buffer);
+#endif
+        if (!_second_phase) _storePage();
+        if (write) _writePage(_second_phase ? _WriteImageAgain : _WriteImageForFullRefresh, 0, 0, page_ys, WIDTH, page_rows);
         _current_page++;
         if (_current_page == _pages)
         {
+          _waitPages();
           _current_page = 0;
+#if ENABLE_GxEPD2_ROW_HASH
+          if (!_second_phase && !_row_hash.changed()) return false; // same as last frame sent, no refresh
+#endif
           if (epd2.hasFastPartialUpdate)
           {
             if (!_second_phase)
             {
               epd2.refresh(false); // full update after first phase
-              _second_phase = true;
-              fillScreen(GxEPD_WHITE);
-              return true;
+              if (_page_store_ok) _writeStoredPages(); // second phase without drawing again
+              else
+              {
+                _second_phase = true;
+                fillScreen(GxEPD_WHITE);
+                return true;
+              }
             }
             //else epd2.refresh(true); // partial update after second phase
           } else epd2.refresh(false); // full update after only phase
@@ -332,6 +489,7 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
     // GxEPD style paged drawing; drawCallback() is called as many times as needed
     void drawPaged(void (*drawCallback)(const void*), const void* pv)
     {
+      _invalidateRowHashes();
       if (1 == _pages)
       {
         fillScreen(GxEPD_WHITE);
@@ -375,13 +533,21 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
               fillScreen(GxEPD_WHITE);
               drawCallback(pv);
               uint32_t offset = _reverse ? (_page_height - (dest_ye - dest_ys)) * _pw_w / 8 : 0;
-              if (phase == 1) epd2.writeImage(_buffer + offset, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
-              else epd2.writeImageAgain(_buffer + offset, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
+              if (phase == 1) _storePage();
+              _writePage(phase == 1 ? _WriteImage : _WriteImageAgain, offset, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
             }
+            else if (phase == 1) _storePage();
           }
+          _waitPages();
           epd2.refresh(_pw_x, _pw_y, _pw_w, _pw_h);
           if (!epd2.hasFastPartialUpdate) break;
           // else make both controller buffers have equal content
+          if (_page_store_ok)
+          {
+            _writeStoredPages(); // without drawing again
+            epd2.refresh(_pw_x, _pw_y, _pw_w, _pw_h);
+            break;
+          }
         }
       }
       else // full update
@@ -391,10 +557,13 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
           uint16_t page_ys = _current_page * _page_height;
           fillScreen(GxEPD_WHITE);
           drawCallback(pv);
-          epd2.writeImageForFullRefresh(_buffer, 0, page_ys, WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+          _storePage();
+          _writePage(_WriteImageForFullRefresh, 0, 0, page_ys, WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
         }
+        _waitPages();
         epd2.refresh(false); // full update after first phase
-        if (epd2.hasFastPartialUpdate)
+        if (epd2.hasFastPartialUpdate && _page_store_ok) _writeStoredPages(); // without drawing again
+        else if (epd2.hasFastPartialUpdate)
         {
           // make both controller buffers have equal content
           for (_current_page = 0; _current_page < _pages; _current_page++)
@@ -402,8 +571,9 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
             uint16_t page_ys = _current_page * _page_height;
             fillScreen(GxEPD_WHITE);
             drawCallback(pv);
-            epd2.writeImageAgain(_buffer, 0, page_ys, WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+            _writePage(_WriteImageAgain, 0, 0, page_ys, WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
           }
+          _waitPages();
           //epd2.refresh(true); // partial update after second phase // not needed
         }
         epd2.powerOff();
@@ -411,105 +581,186 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
       _current_page = 0;
     }
 
-    void drawInvertedBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+    // band parallel drawing to the page buffer, e.g. to the full screen buffer of a large panel:
+    // the rows of the current page are split into bands, one per worker and one for the calling task;
+    // render(band, p) draws the scene to a band, on all of them in parallel, and drawBands() returns when all are done;
+    // render must draw only to band, e.g. with GxEPD2_DisplayList::replay(band), as it runs on the workers, see GxEPD2_PageWriter.h
+    void drawBands(void (*render)(GxEPD2_GFX_ROOT_CLASS& band, const void* p), const void* p, GxEPD2_PageWriter* workers[] = 0, uint8_t count = 0)
     {
-      // taken from Adafruit_GFX.cpp, modified
-      int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-      uint8_t byte = 0;
-      for (int16_t j = 0; j < h; j++)
-      {
-        for (int16_t i = 0; i < w; i++ )
-        {
-          if (i & 7) byte <<= 1;
-          else
-          {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-            byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-#else
-            byte = bitmap[j * byteWidth + i / 8];
+      uint16_t ys = gx_uint16_min(_current_page * _page_height, _pw_h);
+      uint16_t rows = gx_uint16_min(_page_height, _pw_h - ys);
+      _drawing_bands = true; // no dirty boxes from the workers
+      GxEPD2_Band<GxEPD2_BW>::drawBands(*this, rows, render, p, workers, count);
+      _drawing_bands = false;
+      if (rows > 0) _markDirty(_pw_x, _pw_y, _pw_w, rows);
+    }
+
+    // bounds of the current page in drawing coordinates, according to rotation, mirror and partial window;
+    // only pixels inside go to the buffer, e.g. drawPaged() callbacks can skip whole widgets outside, see pageIntersects()
+    void getPageBounds(int16_t& x, int16_t& y, int16_t& w, int16_t& h)
+    {
+      uint16_t ys = gx_uint16_min(_current_page * _page_height, _pw_h);
+      uint16_t px = _pw_x, py = _pw_y + ys, pw = _pw_w, ph = gx_uint16_min(_page_height, _pw_h - ys);
+      _unrotate(px, py, pw, ph);
+      if (_mirror) px = width() - px - pw;
+      x = px;
+      y = py;
+      w = pw;
+      h = ph;
+    }
+
+    // true if the rectangle is (partly) on the current page
+    bool pageIntersects(int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      if ((w <= 0) || (h <= 0)) return false;
+      return _pageIntersects(x, y, int32_t(x) + w, int32_t(y) + h);
+    }
+
+    // page culling, see GxEPD2_PageCull.h: lines outside the current page are skipped
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+    {
+      if (!_pageCull().intersectsLine(x0, y0, x1, y1)) return;
+      GxEPD2_GFX_BASE_CLASS::drawLine(x0, y0, x1, y1, color);
+    }
+
+    // bitmaps are drawn for the rows and columns on the current page only
+    using GxEPD2_GFX_BASE_CLASS::drawBitmap;
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, color, false, false, true);
+    }
+
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, bg, true, false, true);
+    }
+
+    void drawBitmap(int16_t x, int16_t y, uint8_t* bitmap, int16_t w, int16_t h, uint16_t color)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, color, false, false, false);
+    }
+
+    void drawBitmap(int16_t x, int16_t y, uint8_t* bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, bg, true, false, false);
+    }
+
+#if ENABLE_GxEPD2_TEXT_CULLING
+    // characters outside the current page are not drawn, the cursor advances and wraps as in Adafruit_GFX::write()
+    using GxEPD2_GFX_BASE_CLASS::write;
+    size_t write(uint8_t c)
+    {
+      int16_t cx = cursor_x, cy = cursor_y, bx, by, bw, bh;
+      if (!GxEPD2_PageCull::charBox(c, gfxFont, textsize_x, textsize_y, wrap, _width, cx, cy, bx, by, bw, bh)) return GxEPD2_GFX_BASE_CLASS::write(c);
+      if (_pageIntersects(bx, by, int32_t(bx) + bw, int32_t(by) + bh)) return GxEPD2_GFX_BASE_CLASS::write(c); // wraps the same way
+      cursor_x = cx;
+      cursor_y = cy;
+      return 1;
+    }
 #endif
-          }
-          if (!(byte & 0x80))
-          {
-            drawPixel(x + i, y + j, color);
-          }
-        }
-      }
+
+    void drawInvertedBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+    {
+      _drawBitmap(x, y, bitmap, w, h, color, color, false, true, true);
     }
 
     //  Support for Bitmaps (Sprites) to Controller Buffer and to Screen
     void clearScreen(uint8_t value = 0xFF) // init controller memory and screen (default white)
     {
+      _invalidateRowHashes();
       epd2.clearScreen(value);
     }
     void writeScreenBuffer(uint8_t value = 0xFF) // init controller memory (default white)
     {
+      _invalidateRowHashes();
       epd2.writeScreenBuffer(value);
     }
     // write to controller memory, without screen refresh; x and w should be multiple of 8
     void writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
     {
+      _invalidateRowHashes();
       epd2.writeImage(bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                         int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
     {
+      _invalidateRowHashes();
       epd2.writeImagePart(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
+    // write a bitmap in drawing orientation to controller memory, without screen refresh, at x, y in drawing coordinates of the actual rotation;
+    // transformed by the controller if supported, see GxEPD2_EPD::writeImageRotated(); x and w should be multiple of 8 for rotation 0 or 2,
+    // y and h should be multiple of 8 for rotation 1 or 3
+    void writeImageRotated(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool pgm = false)
+    {
+      _invalidateRowHashes();
+      epd2.writeImageRotated(bitmap, x, y, w, h, getRotation(), invert, pgm);
+    }
     void writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _invalidateRowHashes();
       epd2.writeImage(black, color, x, y, w, h, invert, mirror_y, pgm);
     }
     void writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h)
     {
+      _invalidateRowHashes();
       epd2.writeImage(black, color, x, y, w, h, false, false, false);
     }
     void writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                         int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _invalidateRowHashes();
       epd2.writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                         int16_t x, int16_t y, int16_t w, int16_t h)
     {
+      _invalidateRowHashes();
       epd2.writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, false, false, false);
     }
     // write sprite of native data to controller memory, without screen refresh; x and w should be multiple of 8
     void writeNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _invalidateRowHashes();
       epd2.writeNative(data1, data2, x, y, w, h, invert, mirror_y, pgm);
     }
     // write to controller memory, with screen refresh; x and w should be multiple of 8
     void drawImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
     {
+      _invalidateRowHashes();
       epd2.drawImage(bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void drawImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                        int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
     {
+      _invalidateRowHashes();
       epd2.drawImagePart(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _invalidateRowHashes();
       epd2.drawImage(black, color, x, y, w, h, invert, mirror_y, pgm);
     }
     void drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h)
     {
+      _invalidateRowHashes();
       epd2.drawImage(black, color, x, y, w, h, false, false, false);
     }
     void drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                        int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _invalidateRowHashes();
       epd2.drawImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                        int16_t x, int16_t y, int16_t w, int16_t h)
     {
+      _invalidateRowHashes();
       epd2.drawImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, false, false, false);
     }
     // write sprite of native data to controller memory, with screen refresh; x and w should be multiple of 8
     void drawNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _invalidateRowHashes();
       epd2.drawNative(data1, data2, x, y, w, h, invert, mirror_y, pgm);
     }
     void refresh(bool partial_update_mode = false) // screen refresh from controller memory to full screen
@@ -529,9 +780,15 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
     // turns powerOff() and sets controller to deep sleep for minimum power use, ONLY if wakeable by RST (rst >= 0)
     void hibernate()
     {
+      _invalidateRowHashes();
       epd2.hibernate();
     }
   private:
+    struct GxEPD2_DirtyBox
+    {
+      uint16_t xs, ys, xe, ye; // panel coordinates, end exclusive
+    };
+    friend class GxEPD2_Band<GxEPD2_BW>;
     template <typename T> static inline void
     _swap_(T & a, T & b)
     {
@@ -567,8 +824,343 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
           break;
       }
     }
+    // inverse of _rotate(), from panel to drawing coordinates
+    void _unrotate(uint16_t& x, uint16_t& y, uint16_t& w, uint16_t& h)
+    {
+      switch (getRotation())
+      {
+        case 1:
+          _swap_(x, y);
+          _swap_(w, h);
+          y = WIDTH - y - h;
+          break;
+        case 2:
+          x = WIDTH - x - w;
+          y = HEIGHT - y - h;
+          break;
+        case 3:
+          _swap_(x, y);
+          _swap_(w, h);
+          x = HEIGHT - x - w;
+          break;
+      }
+    }
+    // true if x0 <= x < x1, y0 <= y < y1 in drawing coordinates intersects the current page
+    bool _pageIntersects(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+    {
+      return _pageCull().intersects(x0, y0, x1, y1);
+    }
+    GxEPD2_PageCull _pageCull()
+    {
+      int16_t x, y, w, h;
+      getPageBounds(x, y, w, h);
+      return GxEPD2_PageCull(x, y, w, h);
+    }
+    // draws the part of a bitmap on the current page, set bits with color, clear bits with bg if use_bg; invert swaps set and clear
+    void _drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg, bool use_bg, bool invert, bool pgm)
+    {
+      _pageCull().drawBitmap(*this, x, y, bitmap, w, h, color, bg, use_bg, invert, pgm);
+    }
+    // draws a pixel to rows clip_ys <= y < clip_ye of the page buffer
+    void _drawPixel(int16_t x, int16_t y, uint16_t color, uint16_t clip_ys, uint16_t clip_ye)
+    {
+      if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return;
+      if (_mirror) x = width() - x - 1;
+      // check rotation, move pixel around if necessary
+      switch (getRotation())
+      {
+        case 1:
+          _swap_(x, y);
+          x = WIDTH - x - 1;
+          break;
+        case 2:
+          x = WIDTH - x - 1;
+          y = HEIGHT - y - 1;
+          break;
+        case 3:
+          _swap_(x, y);
+          y = HEIGHT - y - 1;
+          break;
+      }
+      // transpose partial window to 0,0
+      x -= _pw_x;
+      y -= _pw_y;
+      // clip to (partial) window
+      if ((x < 0) || (x >= _pw_w) || (y < 0) || (y >= _pw_h)) return;
+      // adjust for current page
+      y -= _current_page * _page_height;
+      // check if in current page
+      if ((y < clip_ys) || (y >= clip_ye)) return;
+      _markDirty(x + _pw_x, y + _pw_y, 1, 1);
+      if (_reverse) y = _page_height - y - 1;
+      uint32_t i = x / 8 + uint32_t(y) * (_pw_w / 8);
+      if (color)
+        _buffer[i] = (_buffer[i] | (1 << (7 - x % 8)));
+      else
+        _buffer[i] = (_buffer[i] & (0xFF ^ (1 << (7 - x % 8))));
+    }
+    // fills the buffer window xs <= x < xe, ys <= y < ye
+    void _fillBuffer(uint16_t xs, uint16_t ys, uint16_t xe, uint16_t ye, uint16_t color)
+    {
+      uint8_t data = color ? 0xFF : 0x00;
+      uint16_t row_bytes = _pw_w / 8;
+      if ((xs == 0) && (xe == _pw_w)) memset(_buffer + ys * row_bytes, data, (ye - ys) * row_bytes); // whole rows
+      else for (uint16_t y1 = ys; y1 < ye; y1++) _fillSpan(_buffer + y1 * row_bytes, xs, xe, data);
+    }
+    // transforms a rectangle to the buffer of the current page, as drawPixel() does for a pixel
+    // result is the buffer window xs <= x < xe, ys <= y < ye, false if nothing is visible; clip_ys, clip_ye : rows of the page buffer
+    bool _bufferRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t& xs, uint16_t& ys, uint16_t& xe, uint16_t& ye, uint16_t clip_ys = 0, uint16_t clip_ye = 0xFFFF)
+    {
+      int32_t x0 = x, y0 = y, x1 = int32_t(x) + w, y1 = int32_t(y) + h;
+      if (w < 0) // negative width extends to the left, as in Adafruit_SPITFT
+      {
+        x0 = x1 + 1;
+        x1 = int32_t(x) + 1;
+      }
+      if (h < 0)
+      {
+        y0 = y1 + 1;
+        y1 = int32_t(y) + 1;
+      }
+      // clip to screen
+      if (x0 < 0) x0 = 0;
+      if (y0 < 0) y0 = 0;
+      if (x1 > width()) x1 = width();
+      if (y1 > height()) y1 = height();
+      if ((x0 >= x1) || (y0 >= y1)) return false;
+      uint16_t rx = x0, ry = y0, rw = x1 - x0, rh = y1 - y0;
+      if (_mirror) rx = width() - rx - rw;
+      _rotate(rx, ry, rw, rh);
+      // transpose partial window to 0,0 and clip
+      x0 = int32_t(rx) - _pw_x;
+      y0 = int32_t(ry) - _pw_y;
+      x1 = x0 + rw;
+      y1 = y0 + rh;
+      if (x0 < 0) x0 = 0;
+      if (y0 < 0) y0 = 0;
+      if (x1 > _pw_w) x1 = _pw_w;
+      if (y1 > _pw_h) y1 = _pw_h;
+      // adjust for current page and clip
+      y0 -= int32_t(_current_page) * _page_height;
+      y1 -= int32_t(_current_page) * _page_height;
+      if (y0 < clip_ys) y0 = clip_ys;
+      if (y1 > _page_height) y1 = _page_height;
+      if (y1 > clip_ye) y1 = clip_ye;
+      if ((x0 >= x1) || (y0 >= y1)) return false;
+      xs = x0;
+      xe = x1;
+      ys = _reverse ? _page_height - y1 : y0;
+      ye = _reverse ? _page_height - y0 : y1;
+      return true;
+    }
+    // with ENABLE_GxEPD2_DIRTY_BOXES and full screen buffer: adds a rectangle in panel coordinates to the dirty boxes, x is aligned to bytes;
+    // grows the box of the last rectangle if it touches it, e.g. for runs of pixels, else merges with a box it touches,
+    // else uses a free box, else merges with the box that grows least
+    void _markDirty(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+#if ENABLE_GxEPD2_DIRTY_BOXES
+      if ((_page_height != GxEPD2_Type::HEIGHT) || _drawing_bands) return;
+      GxEPD2_DirtyBox r = {uint16_t(x & ~7), y, uint16_t((x + w + 7) & ~7), uint16_t(y + h)};
+      if ((_dirty_last < _dirty_count) && _touches(r, _dirty[_dirty_last])) return _grow(_dirty[_dirty_last], r);
+      uint8_t best = 0;
+      uint32_t best_growth = 0xFFFFFFFF;
+      for (uint8_t i = 0; i < _dirty_count; i++)
+      {
+        GxEPD2_DirtyBox& b = _dirty[i];
+        GxEPD2_DirtyBox u = b;
+        _grow(u, r);
+        uint32_t growth = _touches(r, b) ? 0 : _area(u) - _area(b);
+        if (growth < best_growth)
+        {
+          best = i;
+          best_growth = growth;
+        }
+      }
+      if ((best_growth > 0) && (_dirty_count < sizeof(_dirty) / sizeof(_dirty[0])))
+      {
+        _dirty_last = _dirty_count;
+        _dirty[_dirty_count++] = r;
+        return;
+      }
+      _dirty_last = best;
+      _grow(_dirty[best], r);
+#else
+      (void) x;
+      (void) y;
+      (void) w;
+      (void) h;
+#endif
+    }
+#if ENABLE_GxEPD2_DIRTY_BOXES
+    static bool _touches(const GxEPD2_DirtyBox& r, const GxEPD2_DirtyBox& b)
+    {
+      return (r.xs <= b.xe) && (r.xe >= b.xs) && (r.ys <= b.ye) && (r.ye >= b.ys);
+    }
+    static void _grow(GxEPD2_DirtyBox& b, const GxEPD2_DirtyBox& r)
+    {
+      b.xs = gx_uint16_min(b.xs, r.xs);
+      b.ys = gx_uint16_min(b.ys, r.ys);
+      b.xe = gx_uint16_max(b.xe, r.xe);
+      b.ye = gx_uint16_max(b.ye, r.ye);
+    }
+    static uint32_t _area(const GxEPD2_DirtyBox& b)
+    {
+      return uint32_t(b.xe - b.xs) * (b.ye - b.ys);
+    }
+    // first row of the buffer part of a dirty box, in the (partial) window buffer
+    uint16_t _dirtyRow(const GxEPD2_DirtyBox& b)
+    {
+      return _reverse ? _page_height - (b.ye - _pw_y) : b.ys - _pw_y;
+    }
+#endif
+    // writes the page buffer from offset to the controller, with the page writer in the background and continues with the second buffer
+    void _writePage(uint8_t what, uint32_t offset, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+      if (!_page_writer) return _writeBuffer(what, _buffer + offset, x, y, w, h);
+      _page_writer->wait(); // the second buffer is free
+      _job_what = what;
+      _job_data = _buffer + offset;
+      _job_x = x;
+      _job_y = y;
+      _job_w = w;
+      _job_h = h;
+      _page_writer->start(_writeJob, this);
+      _swap_(_buffer, _back_buffer);
+      _buffers_swapped = !_buffers_swapped;
+    }
+    void _writeBuffer(uint8_t what, const uint8_t* data, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+      switch (what)
+      {
+        case _WriteImage:
+          epd2.writeImage(data, x, y, w, h);
+          break;
+        case _WriteImageForFullRefresh:
+          epd2.writeImageForFullRefresh(data, x, y, w, h);
+          break;
+        case _WriteImageAgain:
+          epd2.writeImageAgain(data, x, y, w, h);
+          break;
+      }
+    }
+    static void _writeJob(void* p)
+    {
+      GxEPD2_BW* display = (GxEPD2_BW*) p;
+      display->_writeBuffer(display->_job_what, display->_job_data, display->_job_x, display->_job_y, display->_job_w, display->_job_h);
+    }
+    // waits for the page writer, before other controller access; back to the first page buffer
+    void _waitPages()
+    {
+      if (_page_writer) _page_writer->wait();
+      if (_buffers_swapped) _swap_(_buffer, _back_buffer);
+      _buffers_swapped = false;
+    }
+    // first phase of paged drawing: appends the page buffer to the page store, run length encoded
+    void _storePage()
+    {
+      if (0 == _current_page)
+      {
+        _page_store_used = 0;
+        _page_store_ok = (_page_store != 0) && epd2.hasFastPartialUpdate;
+      }
+      if (!_page_store_ok) return;
+      uint32_t n = GxEPD2_rleEncode(_buffer, uint32_t(_page_height) * (_pw_w / 8), _page_store + _page_store_used, _page_store_size - _page_store_used);
+      _page_store_ok = (n > 0);
+      _page_store_used += n;
+    }
+    // second phase of paged drawing from the page store, writes the pages as the first phase did, to the other controller buffer
+    void _writeStoredPages()
+    {
+      const uint8_t* p = _page_store;
+      for (_current_page = 0; _current_page < _pages; _current_page++)
+      {
+        p = GxEPD2_rleDecode(p, _buffer, uint32_t(_page_height) * (_pw_w / 8));
+        uint16_t page_ys = _current_page * _page_height;
+        if (_using_partial_mode)
+        {
+          uint16_t page_ye = _current_page < (_pages - 1) ? page_ys + _page_height : HEIGHT;
+          uint16_t dest_ys = _pw_y + page_ys; // transposed
+          uint16_t dest_ye = gx_uint16_min(_pw_y + _pw_h, _pw_y + page_ye);
+          if (dest_ye > dest_ys)
+          {
+            uint32_t offset = _reverse ? (_page_height - (dest_ye - dest_ys)) * _pw_w / 8 : 0;
+            epd2.writeImageAgain(_buffer + offset, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
+          }
+        }
+        else
+        {
+          uint16_t page_rows = gx_uint16_min(_page_height, HEIGHT - page_ys);
+#if ENABLE_GxEPD2_ROW_HASH
+          if (!_row_hash.changed(page_ys, page_ys + page_rows)) continue; // not written by the first phase either
+#endif
+          epd2.writeImageAgain(_buffer, 0, page_ys, WIDTH, page_rows);
+        }
+      }
+      _current_page = 0;
+    }
+    void _invalidateRowHashes()
+    {
+#if ENABLE_GxEPD2_ROW_HASH
+      _row_hash.invalidate();
+#endif
+    }
+    // with ENABLE_GxEPD2_ROW_HASH and full screen buffer: true if the buffer is the same as the last frame sent
+    bool _rowsUnchanged()
+    {
+#if ENABLE_GxEPD2_ROW_HASH
+      if (_page_height >= GxEPD2_Type::HEIGHT)
+      {
+        if (_row_hash.hashRows(0, HEIGHT, _buffer)) return false;
+        _dirty_count = 0;
+        return true;
+      }
+#endif
+      _invalidateRowHashes();
+      return false;
+    }
+#if ENABLE_GxEPD2_ROW_HASH
+    template<uint16_t, uint16_t> friend class GxEPD2_RowHash;
+    // buffer rows ys <= y < ye of the full screen buffer to the controller, for GxEPD2_RowHash::displayChanged()
+    void _writeChangedRows(uint16_t ys, uint16_t ye, bool again)
+    {
+      uint16_t dest_ys = _reverse ? HEIGHT - ye : ys;
+      if (again) epd2.writeImagePartAgain(_buffer, 0, ys, WIDTH, _page_height, 0, dest_ys, WIDTH, ye - ys);
+      else epd2.writeImagePart(_buffer, 0, ys, WIDTH, _page_height, 0, dest_ys, WIDTH, ye - ys);
+    }
+#endif
+    // sets the bits xs <= x < xe of a buffer row to data
+    static void _fillSpan(uint8_t* row, uint16_t xs, uint16_t xe, uint8_t data)
+    {
+      uint16_t bs = xs / 8, be = (xe - 1) / 8;
+      uint8_t ms = 0xFF >> (xs % 8), me = 0xFF << (7 - (xe - 1) % 8);
+      if (bs == be) ms &= me;
+      row[bs] = (row[bs] & ~ms) | (data & ms);
+      if (bs == be) return;
+      memset(row + bs + 1, data, be - bs - 1);
+      row[be] = (row[be] & ~me) | (data & me);
+    }
   private:
-    uint8_t _buffer[(GxEPD2_Type::WIDTH / 8) * page_height];
+    static const uint16_t _internal_rows = page_height > 0 ? page_height : 1;
+    uint8_t _internal_buffer[(GxEPD2_Type::WIDTH / 8) * _internal_rows];
+    uint8_t* _buffer;
+    uint8_t* _back_buffer;
+    uint32_t _back_buffer_size;
+    bool _buffers_swapped;
+    GxEPD2_PageWriter* _page_writer;
+    enum {_WriteImage, _WriteImageForFullRefresh, _WriteImageAgain};
+    uint8_t _job_what;
+    const uint8_t* _job_data;
+    uint16_t _job_x, _job_y, _job_w, _job_h;
+    GxEPD2_DirtyBox _dirty[ENABLE_GxEPD2_DIRTY_BOXES && ((page_height == GxEPD2_Type::HEIGHT) || (page_height == 0)) ? GxEPD2_DIRTY_BOXES : 1];
+    uint8_t _dirty_count, _dirty_last;
+    uint8_t* _page_store;
+    uint32_t _page_store_size, _page_store_used;
+    bool _page_store_ok;
+    bool _drawing_bands;
+#if ENABLE_GxEPD2_ROW_HASH
+    GxEPD2_RowHash<GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT> _row_hash;
+#endif
+    GxEPD2_TransportBus<GxEPD2_Transport> _bus;
     bool _using_partial_mode, _second_phase, _mirror, _reverse;
     uint16_t _width_bytes, _pixel_bytes;
     int16_t _current_page;
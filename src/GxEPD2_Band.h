@@ -0,0 +1,94 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// band parallel drawing for drawBands() of GxEPD2_BW and GxEPD2_3C: the rows of the current page are split into bands,
+// one per worker and one for the calling task, each band is a drawing target that clips to its rows of the page buffer;
+// the display grants access to its _drawPixel(), _bufferRect() and _fillBuffer() as friend
+
+#ifndef _GxEPD2_Band_H_
+#define _GxEPD2_Band_H_
+
+#ifndef GxEPD2_GFX_ROOT_CLASS
+#if defined(_GFX_H_)
+#define GxEPD2_GFX_ROOT_CLASS GFX
+#else
+#include <Adafruit_GFX.h>
+#define GxEPD2_GFX_ROOT_CLASS Adafruit_GFX
+#endif
+#endif
+
+#include "GxEPD2_PageWriter.h"
+
+template<typename GxEPD2_Display>
+class GxEPD2_Band : public GxEPD2_GFX_ROOT_CLASS
+{
+  public:
+    // draws to rows ys <= y < ye of the page buffer of display
+    GxEPD2_Band(GxEPD2_Display& display, uint16_t ys, uint16_t ye) :
+      GxEPD2_GFX_ROOT_CLASS(display.width(), display.height()), _display(display), _ys(ys), _ye(ye) {};
+    void drawPixel(int16_t x, int16_t y, uint16_t color)
+    {
+      _display._drawPixel(x, y, color, _ys, _ye);
+    };
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+    {
+      fillRect(x, y, w, 1, color);
+    };
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+    {
+      fillRect(x, y, 1, h, color);
+    };
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      uint16_t xs, ys, xe, ye;
+      if (_display._bufferRect(x, y, w, h, xs, ys, xe, ye, _ys, _ye)) _display._fillBuffer(xs, ys, xe, ye, color);
+    };
+    void fillScreen(uint16_t color)
+    {
+      fillRect(0, 0, width(), height(), color);
+    };
+    // render(band, p) on the bands of the first rows of the page buffer, count of them on the workers, the last one in the calling task;
+    // returns when all are done; count is limited to 7
+    static void drawBands(GxEPD2_Display& display, uint16_t rows, void (*render)(GxEPD2_GFX_ROOT_CLASS& band, const void* p), const void* p,
+                          GxEPD2_PageWriter* workers[], uint8_t count)
+    {
+      Job jobs[_max_bands];
+      if (count > _max_bands - 1) count = _max_bands - 1;
+      for (uint8_t i = 0; i <= count; i++)
+      {
+        jobs[i].display = &display;
+        jobs[i].render = render;
+        jobs[i].p = p;
+        jobs[i].ys = uint32_t(rows) * i / (count + 1);
+        jobs[i].ye = uint32_t(rows) * (i + 1) / (count + 1);
+        if (i < count) workers[i]->start(_job, &jobs[i]);
+        else _job(&jobs[i]);
+      }
+      for (uint8_t i = 0; i < count; i++) workers[i]->wait();
+    };
+  private:
+    struct Job
+    {
+      GxEPD2_Display* display;
+      void (*render)(GxEPD2_GFX_ROOT_CLASS& band, const void* p);
+      const void* p;
+      uint16_t ys, ye;
+    };
+    static const uint8_t _max_bands = 8;
+    static void _job(void* p)
+    {
+      Job* job = (Job*) p;
+      GxEPD2_Band band(*job->display, job->ys, job->ye);
+      job->render(band, job->p);
+    };
+    GxEPD2_Display& _display;
+    uint16_t _ys, _ye;
+};
+
+#endif
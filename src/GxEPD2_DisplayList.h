@@ -0,0 +1,157 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// display list for paged drawing: draw the scene once to the list, then replay it for each page,
+// instead of running the drawing code, text layout, number formatting etc. once per page
+//
+//   GxEPD2_DisplayList list(display.width(), display.height(), list_buffer, sizeof(list_buffer));
+//   drawScene(list); // any Adafruit_GFX drawing code
+//   display.firstPage();
+//   do list.replay(display); while (display.nextPage());
+//
+// primitives are recorded as filled rectangles with color, in caller supplied memory;
+// adjacent pixels and rectangles of the same color are merged, e.g. glyph columns or rows of text;
+// on replay the span kernels of GxEPD2_BW, GxEPD2_3C and GxEPD2_7C clip each rectangle to the current page.
+
+#ifndef _GxEPD2_DisplayList_H_
+#define _GxEPD2_DisplayList_H_
+
+#ifndef GxEPD2_GFX_ROOT_CLASS
+#if defined(_GFX_H_)
+#define GxEPD2_GFX_ROOT_CLASS GFX
+#else
+#include <Adafruit_GFX.h>
+#define GxEPD2_GFX_ROOT_CLASS Adafruit_GFX
+#endif
+#endif
+
+class GxEPD2_DisplayList : public GxEPD2_GFX_ROOT_CLASS
+{
+  public:
+    // w, h : size according to the rotation of the display the list is replayed to
+    GxEPD2_DisplayList(int16_t w, int16_t h, uint8_t* buffer, uint32_t size) :
+      GxEPD2_GFX_ROOT_CLASS(w, h), _buffer(buffer), _size(size), _used(0), _last(0), _overflow(false) {};
+    // removes all records
+    void clear()
+    {
+      _used = 0;
+      _overflow = false;
+    };
+    // bytes used
+    uint32_t used()
+    {
+      return _used;
+    };
+    // true if records were dropped, replay() is incomplete, draw directly instead
+    bool overflow()
+    {
+      return _overflow;
+    };
+    void drawPixel(int16_t x, int16_t y, uint16_t color)
+    {
+      _add(x, y, 1, 1, color);
+    };
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+    {
+      fillRect(x, y, w, 1, color);
+    };
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+    {
+      fillRect(x, y, 1, h, color);
+    };
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      if (w < 0) // negative width extends to the left, as in Adafruit_SPITFT
+      {
+        x += w + 1;
+        w = -w;
+      }
+      if (h < 0)
+      {
+        y += h + 1;
+        h = -h;
+      }
+      _add(x, y, w, h, color);
+    };
+    // covers everything drawn before, restarts the list
+    void fillScreen(uint16_t color)
+    {
+      clear();
+      _add(0, 0, width(), height(), color);
+    };
+    // draws the recorded rectangles to target, e.g. a GxEPD2_BW, GxEPD2_3C or GxEPD2_7C display, in recording order
+    void replay(GxEPD2_GFX_ROOT_CLASS& target)
+    {
+      for (uint32_t i = 0; i < _used; i += _record_size)
+      {
+        const uint8_t* r = _buffer + i;
+        target.fillRect(_get16(r + 2), _get16(r + 4), _get16(r + 6), _get16(r + 8), _get16(r));
+      }
+    };
+  private:
+    // record: color, x, y, w, h, 16 bit little endian each
+    static const uint8_t _record_size = 10;
+    static int16_t _get16(const uint8_t* p)
+    {
+      return int16_t(p[0] | (p[1] << 8));
+    };
+    static void _put16(uint8_t* p, int16_t value)
+    {
+      p[0] = uint16_t(value) & 0xFF;
+      p[1] = uint16_t(value) >> 8;
+    };
+    void _add(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      // clip to list area, rectangles outside are not recorded
+      int32_t x1 = int32_t(x) + w, y1 = int32_t(y) + h;
+      if (x < 0) x = 0;
+      if (y < 0) y = 0;
+      if (x1 > width()) x1 = width();
+      if (y1 > height()) y1 = height();
+      if ((x >= x1) || (y >= y1)) return;
+      w = x1 - x;
+      h = y1 - y;
+      if (_used > 0) // merge with last record if the union is a rectangle
+      {
+        uint8_t* r = _buffer + _last;
+        int16_t rx = _get16(r + 2), ry = _get16(r + 4), rw = _get16(r + 6), rh = _get16(r + 8);
+        if (uint16_t(_get16(r)) == color)
+        {
+          if ((ry == y) && (rh == h) && (rx + rw == x))
+          {
+            _put16(r + 6, rw + w);
+            return;
+          }
+          if ((rx == x) && (rw == w) && (ry + rh == y))
+          {
+            _put16(r + 8, rh + h);
+            return;
+          }
+        }
+      }
+      if (_used + _record_size > _size)
+      {
+        _overflow = true;
+        return;
+      }
+      uint8_t* r = _buffer + _used;
+      _put16(r, color);
+      _put16(r + 2, x);
+      _put16(r + 4, y);
+      _put16(r + 6, w);
+      _put16(r + 8, h);
+      _last = _used;
+      _used += _record_size;
+    };
+    uint8_t* _buffer;
+    uint32_t _size, _used, _last;
+    bool _overflow;
+};
+
+#endif
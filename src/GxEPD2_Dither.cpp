@@ -0,0 +1,340 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#include "GxEPD2_Dither.h"
+
+// 8x8 ordered dither matrix, thresholds 4 * value + 2
+static const uint8_t bayer8[8][8] PROGMEM =
+{
+  { 0, 32,  8, 40,  2, 34, 10, 42},
+  {48, 16, 56, 24, 50, 18, 58, 26},
+  {12, 44,  4, 36, 14, 46,  6, 38},
+  {60, 28, 52, 20, 62, 30, 54, 22},
+  { 3, 35, 11, 43,  1, 33,  9, 41},
+  {51, 19, 59, 27, 49, 17, 57, 25},
+  {15, 47,  7, 39, 13, 45,  5, 37},
+  {63, 31, 55, 23, 61, 29, 53, 21}
+};
+
+// panel colors in the order of the native color index of GxEPD2_7C, black and white first for all palettes
+static const uint8_t color7_rgb[7][3] PROGMEM =
+{
+  {0, 0, 0}, {255, 255, 255}, {0, 255, 0}, {0, 0, 255}, {255, 0, 0}, {255, 255, 0}, {255, 165, 0}
+};
+
+GxEPD2_Dither::GxEPD2_Dither(Palette palette, Method method, uint16_t color) :
+  _palette(palette), _configured_method(method), _method(method), _color(color), _width(0), _y(0), _state(0), _flip(false), _acc1(0), _acc2(0)
+{
+  _channels = (palette == ThreeColor) || (palette == SevenColor) ? 3 : 1;
+  _colors = palette == SevenColor ? 7 : palette == ThreeColor ? 3 : palette == Grey4 ? 4 : 2;
+  for (uint8_t i = 0; i < 7; i++)
+  {
+    for (uint8_t c = 0; c < 3; c++) _palette_rgb[i][c] = pgm_read_byte(&color7_rgb[i][c]);
+  }
+  if (palette == ThreeColor) // the panel color from RGB565
+  {
+    _palette_rgb[2][0] = ((color >> 8) & 0xF8) | (color >> 13);
+    _palette_rgb[2][1] = ((color >> 3) & 0xFC) | ((color >> 9) & 0x03);
+    _palette_rgb[2][2] = ((color << 3) & 0xF8) | ((color >> 2) & 0x07);
+  }
+}
+
+uint32_t GxEPD2_Dither::stateSize(uint16_t width, Palette palette, Method method)
+{
+  uint8_t channels = (palette == ThreeColor) || (palette == SevenColor) ? 3 : 1;
+  uint8_t rows = method == Atkinson ? 2 : method == FloydSteinberg ? 1 : 0;
+  return GxEPD2_DITHER_STATE(width, channels, rows) * sizeof(int16_t);
+}
+
+bool GxEPD2_Dither::begin(uint16_t width, int16_t* state, uint32_t size)
+{
+  bool ok = true;
+  _width = width;
+  _y = 0;
+  _flip = false;
+  _state = state;
+  _method = _configured_method;
+  uint32_t needed = stateSize(width, _palette, _method);
+  if ((needed > 0) && (!state || (size < needed)))
+  {
+    _method = Bayer;
+    _state = 0;
+    ok = false;
+  }
+  if (_state) memset(_state, 0, needed);
+  return ok;
+}
+
+void GxEPD2_Dither::rgbRow(const uint8_t* rgb, uint8_t* out1, uint8_t* out2, bool bgr)
+{
+  _row(rgb, 0, bgr, out1, out2);
+}
+
+void GxEPD2_Dither::rgb565Row(const uint16_t* rgb565, uint8_t* out1, uint8_t* out2)
+{
+  _row(0, rgb565, false, out1, out2);
+}
+
+void GxEPD2_Dither::drawRow(GxEPD2_GFX_ROOT_CLASS& target, int16_t x, int16_t y, const uint8_t* out1, const uint8_t* out2)
+{
+  uint16_t run = 0;
+  uint8_t last = 0;
+  for (uint16_t i = 0; i <= _width; i++)
+  {
+    uint8_t index = 0;
+    if (i < _width)
+    {
+      switch (_palette)
+      {
+        case BW:
+          index = (out1[i / 8] >> (7 - i % 8)) & 0x01;
+          break;
+        case Grey4:
+          index = (out1[i / 4] >> (2 * (3 - i % 4))) & 0x03;
+          break;
+        case ThreeColor:
+          index = !((out2[i / 8] >> (7 - i % 8)) & 0x01) ? 2 : (out1[i / 8] >> (7 - i % 8)) & 0x01;
+          break;
+        case SevenColor:
+          index = (out1[i / 2] >> (i & 1 ? 0 : 4)) & 0x0F;
+          break;
+      }
+    }
+    if ((i > 0) && ((i == _width) || (index != last)))
+    {
+      target.fillRect(x + i - run, y, run, 1, _color565(last));
+      run = 0;
+    }
+    last = index;
+    run++;
+  }
+}
+
+uint16_t GxEPD2_Dither::_color565(uint8_t index)
+{
+  static const uint16_t grey[4] = {GxEPD_BLACK, GxEPD_DARKGREY, GxEPD_LIGHTGREY, GxEPD_WHITE};
+  static const uint16_t colors[7] = {GxEPD_BLACK, GxEPD_WHITE, GxEPD_GREEN, GxEPD_BLUE, GxEPD_RED, GxEPD_YELLOW, GxEPD_ORANGE};
+  switch (_palette)
+  {
+    case BW:
+      return index ? GxEPD_WHITE : GxEPD_BLACK;
+    case Grey4:
+      return grey[index & 0x03];
+    case ThreeColor:
+      return index == 2 ? _color : index ? GxEPD_WHITE : GxEPD_BLACK;
+    default:
+      return index < 7 ? colors[index] : GxEPD_WHITE;
+  }
+}
+
+// reads pixel x to c, as r, g, b for N 3, as luminance for N 1
+template <uint8_t N> void GxEPD2_Dither::_pixel(const uint8_t* rgb, const uint16_t* rgb565, bool bgr, uint16_t x, int16_t* c)
+{
+  int16_t r, g, b;
+  if (rgb)
+  {
+    const uint8_t* p = rgb + 3 * uint32_t(x);
+    r = p[bgr ? 2 : 0];
+    g = p[1];
+    b = p[bgr ? 0 : 2];
+  }
+  else
+  {
+    uint16_t v = rgb565[x];
+    r = ((v >> 8) & 0xF8) | (v >> 13);
+    g = ((v >> 3) & 0xFC) | ((v >> 9) & 0x03);
+    b = ((v << 3) & 0xF8) | ((v >> 2) & 0x07);
+  }
+  if (N == 1) c[0] = (r * 77 + g * 150 + b * 29) >> 8;
+  else
+  {
+    c[0] = r;
+    c[1] = g;
+    c[2] = b;
+  }
+}
+
+// nearest panel color of c, clamped to 0..255; c is replaced by the color, returns the palette index
+template <uint8_t N> uint8_t GxEPD2_Dither::_quantize(int16_t* c)
+{
+  for (uint8_t i = 0; i < N; i++) c[i] = c[i] < 0 ? 0 : c[i] > 255 ? 255 : c[i];
+  if (N == 1)
+  {
+    uint8_t steps = _colors - 1;
+    uint8_t index = (steps * c[0] + 127) / 255;
+    c[0] = index * 255 / steps;
+    return index;
+  }
+  uint8_t index = 0;
+  int32_t best = 0x7FFFFFFF;
+  for (uint8_t i = 0; i < _colors; i++)
+  {
+    int32_t dr = c[0] - _palette_rgb[i][0], dg = c[1] - _palette_rgb[i][1], db = c[2] - _palette_rgb[i][2];
+    int32_t d = dr * dr + dg * dg + db * db;
+    if (d < best)
+    {
+      best = d;
+      index = i;
+    }
+  }
+  for (uint8_t i = 0; i < N; i++) c[i] = _palette_rgb[index][i];
+  return index;
+}
+
+// shifts the native bits of pixel x into the accumulators, stores full bytes, the last byte padded with white
+void GxEPD2_Dither::_put(uint8_t index, uint16_t x, uint8_t* out1, uint8_t* out2)
+{
+  uint8_t pad;
+  switch (_palette)
+  {
+    case BW:
+      _acc1 = (_acc1 << 1) | index;
+      pad = 7 - x % 8;
+      if ((pad == 0) || (x == _width - 1)) out1[x / 8] = (_acc1 << pad) | (0xFF >> (8 - pad));
+      break;
+    case Grey4:
+      _acc1 = (_acc1 << 2) | index;
+      pad = 2 * (3 - x % 4);
+      if ((pad == 0) || (x == _width - 1)) out1[x / 4] = (_acc1 << pad) | (0xFF >> (8 - pad));
+      break;
+    case ThreeColor:
+      _acc1 = (_acc1 << 1) | (index != 0);
+      _acc2 = (_acc2 << 1) | (index != 2);
+      pad = 7 - x % 8;
+      if ((pad == 0) || (x == _width - 1))
+      {
+        out1[x / 8] = (_acc1 << pad) | (0xFF >> (8 - pad));
+        out2[x / 8] = (_acc2 << pad) | (0xFF >> (8 - pad));
+      }
+      break;
+    case SevenColor:
+      _acc1 = (_acc1 << 4) | index;
+      if (x & 1) out1[x / 2] = _acc1;
+      else if (x == _width - 1) out1[x / 2] = (_acc1 << 4) | 0x01;
+      break;
+  }
+}
+
+void GxEPD2_Dither::_row(const uint8_t* rgb, const uint16_t* rgb565, bool bgr, uint8_t* out1, uint8_t* out2)
+{
+  if ((_method == Bayer) || (_method == Threshold))
+  {
+    if (_channels == 1) _bayerGrey(rgb, rgb565, bgr, out1);
+    else
+    {
+      int16_t c[3];
+      for (uint16_t x = 0; x < _width; x++)
+      {
+        _pixel<3>(rgb, rgb565, bgr, x, c);
+        if (_method == Bayer)
+        {
+          // the threshold of _bayerGrey() as offset, -126..126: half the step of 255 between the primaries of ThreeColor and SevenColor
+          int16_t offset = 4 * int16_t(pgm_read_byte(&bayer8[_y & 7][x & 7])) + 2 - 128;
+          for (uint8_t i = 0; i < 3; i++) c[i] += offset;
+        }
+        _put(_quantize<3>(c), x, out1, out2);
+      }
+    }
+  }
+  else if (_channels == 1) _diffuse<1>(rgb, rgb565, bgr, out1, out2);
+  else _diffuse<3>(rgb, rgb565, bgr, out1, out2);
+  _y++;
+}
+
+// error diffusion of N channels, errors are kept 16 times in the state rows, at (x + 1) * N for x = -1 .. width
+template <uint8_t N> void GxEPD2_Dither::_diffuse(const uint8_t* rgb, const uint16_t* rgb565, bool bgr, uint8_t* out1, uint8_t* out2)
+{
+  int16_t c[N], v[N];
+  if (_method == FloydSteinberg)
+  {
+    // e: errors for the next row, written behind x as x advances;
+    // 7/16 to the right is carried in right, 3/16, 5/16, 1/16 go below left, below and below right
+    int16_t right[N], prev[N];
+    for (uint8_t i = 0; i < N; i++) right[i] = prev[i] = 0;
+    for (uint16_t x = 0; x < _width; x++)
+    {
+      int16_t* e = _state + (x + 1) * N;
+      _pixel<N>(rgb, rgb565, bgr, x, c);
+      for (uint8_t i = 0; i < N; i++) c[i] = v[i] = c[i] + ((e[i] + right[i] + 8) >> 4);
+      uint8_t index = _quantize<N>(c);
+      for (uint8_t i = 0; i < N; i++)
+      {
+        int16_t err = (v[i] < 0 ? 0 : v[i] > 255 ? 255 : v[i]) - c[i];
+        e[i - N] += 3 * err;
+        e[i] = 5 * err + prev[i];
+        prev[i] = err;
+        right[i] = 7 * err;
+      }
+      _put(index, x, out1, out2);
+    }
+  }
+  else // Atkinson
+  {
+    // a: errors for this row, replaced by the errors for the row after next; b: errors for the next row; 1/8 each
+    uint32_t row = GxEPD2_DITHER_STATE(_width, N, 1);
+    int16_t* a = _state + (_flip ? row : 0);
+    int16_t* b = _state + (_flip ? 0 : row);
+    int16_t r1[N], r2[N];
+    for (uint8_t i = 0; i < N; i++) r1[i] = r2[i] = b[i] = b[row - N + i] = 0; // margins of b
+    for (uint16_t x = 0; x < _width; x++)
+    {
+      int16_t* ea = a + (x + 1) * N;
+      int16_t* eb = b + (x + 1) * N;
+      _pixel<N>(rgb, rgb565, bgr, x, c);
+      for (uint8_t i = 0; i < N; i++) c[i] = v[i] = c[i] + ((ea[i] + r1[i] + r2[i] + 8) >> 4);
+      uint8_t index = _quantize<N>(c);
+      for (uint8_t i = 0; i < N; i++)
+      {
+        int16_t d = 2 * ((v[i] < 0 ? 0 : v[i] > 255 ? 255 : v[i]) - c[i]);
+        eb[i - N] += d;
+        eb[i] += d;
+        eb[i + N] += d;
+        ea[i] = d;
+        r2[i] = r1[i];
+        r1[i] = d;
+      }
+      _put(index, x, out1, out2);
+    }
+    _flip = !_flip;
+  }
+}
+
+// ordered dither or threshold of luminance to 2 or 4 levels, 8 pixels at a time;
+// the loops over the 8 pixels have no branches, for the vectorizer of the host compilers
+void GxEPD2_Dither::_bayerGrey(const uint8_t* rgb, const uint16_t* rgb565, bool bgr, uint8_t* out1)
+{
+  uint16_t t[8];
+  for (uint8_t j = 0; j < 8; j++) t[j] = _method == Bayer ? 4 * pgm_read_byte(&bayer8[_y & 7][j]) + 2 : 128;
+  uint16_t steps = _colors - 1, w0 = bgr ? 29 : 77, w2 = bgr ? 77 : 29;
+  for (uint16_t x0 = 0; x0 < _width; x0 += 8)
+  {
+    uint16_t l[8];
+    if (rgb && (x0 + 8 <= _width))
+    {
+      const uint8_t* p = rgb + 3 * uint32_t(x0);
+      for (uint8_t j = 0; j < 8; j++) l[j] = (p[3 * j] * w0 + p[3 * j + 1] * 150 + p[3 * j + 2] * w2) >> 8;
+    }
+    else
+    {
+      for (uint8_t j = 0; j < 8; j++)
+      {
+        int16_t c[1] = {255}; // padding is white
+        if (x0 + j < _width) _pixel<1>(rgb, rgb565, bgr, x0 + j, c);
+        l[j] = c[0];
+      }
+    }
+    for (uint8_t j = 0; j < 8; j++) l[j] = (steps * (l[j] + (l[j] >> 7)) + t[j]) >> 8; // level index 0..steps, 255 scaled to 256
+    if (steps == 1) out1[x0 / 8] = (l[0] << 7) | (l[1] << 6) | (l[2] << 5) | (l[3] << 4) | (l[4] << 3) | (l[5] << 2) | (l[6] << 1) | l[7];
+    else
+    {
+      out1[x0 / 4] = (l[0] << 6) | (l[1] << 4) | (l[2] << 2) | l[3];
+      if (x0 + 4 < _width) out1[x0 / 4 + 1] = (l[4] << 6) | (l[5] << 4) | (l[6] << 2) | l[7];
+    }
+  }
+}
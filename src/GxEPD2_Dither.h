@@ -0,0 +1,84 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// row by row dithering of RGB pictures to panel native rows, e.g. for bitmaps read from SD or WiFi,
+// without a full resolution buffer: error diffusion keeps one (Floyd-Steinberg) or two (Atkinson) rows of error state
+//
+//   int16_t state[GxEPD2_DITHER_STATE(400, 3, 2)]; // width, channels, rows: see stateSize()
+//   GxEPD2_Dither dither(GxEPD2_Dither::ThreeColor, GxEPD2_Dither::Atkinson);
+//   dither.begin(400, state, sizeof(state));
+//   for (each row y of 400 RGB pixels)
+//   {
+//     dither.rgbRow(rgb, black, color, true); // true for BGR, as in .bmp files
+//     display.epd2.writeImage(black, color, 0, y, 400, 1); // or dither.drawRow(display, 0, y, black, color) to a page buffer
+//   }
+//
+// native rows: BW : 1 bit per pixel, 1 white, as for writeImage(); Grey4 : 2 bits per pixel, 3 white, as for writeImage_4G();
+// ThreeColor : black and color rows, 0 black, 0 colored, as for writeImage(black, color, ...); SevenColor : 4 bits per pixel, as for writeNative()
+
+#ifndef _GxEPD2_Dither_H_
+#define _GxEPD2_Dither_H_
+
+#ifndef GxEPD2_GFX_ROOT_CLASS
+#if defined(_GFX_H_)
+#define GxEPD2_GFX_ROOT_CLASS GFX
+#else
+#include <Adafruit_GFX.h>
+#define GxEPD2_GFX_ROOT_CLASS Adafruit_GFX
+#endif
+#endif
+
+#include "GxEPD2.h"
+
+// number of int16_t for the error state of width pixels, channels 1 for BW and Grey4, 3 for colors, rows 1 Floyd-Steinberg, 2 Atkinson
+#define GxEPD2_DITHER_STATE(width, channels, rows) ((uint32_t(width) + 2) * (channels) * (rows))
+
+class GxEPD2_Dither
+{
+  public:
+    enum Palette {BW, Grey4, ThreeColor, SevenColor};
+    enum Method {Threshold, Bayer, FloydSteinberg, Atkinson};
+    // color : the third color of ThreeColor panels, GxEPD_RED or GxEPD_YELLOW
+    GxEPD2_Dither(Palette palette = BW, Method method = FloydSteinberg, uint16_t color = GxEPD_RED);
+    // bytes of error state needed for width pixels
+    static uint32_t stateSize(uint16_t width, Palette palette, Method method);
+    // starts a picture of width pixels at its first row; state in caller supplied memory, not needed for Threshold and Bayer;
+    // returns false if size is too small for the method, Bayer is used instead for this picture
+    bool begin(uint16_t width, int16_t* state = 0, uint32_t size = 0);
+    // dithers the next row of RGB888 pixels, 3 bytes each, in order blue, green, red if bgr, to native rows out1, out2 (see above)
+    void rgbRow(const uint8_t* rgb, uint8_t* out1, uint8_t* out2 = 0, bool bgr = false);
+    // dithers the next row of RGB565 pixels
+    void rgb565Row(const uint16_t* rgb565, uint8_t* out1, uint8_t* out2 = 0);
+    // draws native rows to a display or page buffer as runs of panel colors, at x, y in drawing coordinates
+    void drawRow(GxEPD2_GFX_ROOT_CLASS& target, int16_t x, int16_t y, const uint8_t* out1, const uint8_t* out2 = 0);
+    // method used for the current picture
+    Method method()
+    {
+      return _method;
+    };
+  private:
+    void _row(const uint8_t* rgb, const uint16_t* rgb565, bool bgr, uint8_t* out1, uint8_t* out2);
+    template <uint8_t N> void _diffuse(const uint8_t* rgb, const uint16_t* rgb565, bool bgr, uint8_t* out1, uint8_t* out2);
+    void _bayerGrey(const uint8_t* rgb, const uint16_t* rgb565, bool bgr, uint8_t* out1);
+    template <uint8_t N> inline void _pixel(const uint8_t* rgb, const uint16_t* rgb565, bool bgr, uint16_t x, int16_t* c);
+    template <uint8_t N> inline uint8_t _quantize(int16_t* c);
+    inline void _put(uint8_t index, uint16_t x, uint8_t* out1, uint8_t* out2);
+    uint16_t _color565(uint8_t index);
+    Palette _palette;
+    Method _configured_method, _method; // as constructed, as used for the current picture
+    uint16_t _color;
+    uint8_t _palette_rgb[7][3];
+    uint8_t _channels, _colors;
+    uint16_t _width, _y;
+    int16_t* _state;
+    bool _flip;
+    uint8_t _acc1, _acc2; // bits of the native byte being assembled
+};
+
+#endif
@@ -17,11 +17,13 @@
 #include <avr/pgmspace.h>
 #endif
 
+static GxEPD2_TransportBus<GxEPD2_HwSpi> GxEPD2_hw_spi_bus; // default bus, GxEPD2_HwSpi has no state
+
 GxEPD2_EPD::GxEPD2_EPD(int8_t cs, int8_t dc, int8_t rst, int8_t busy, int8_t busy_level, uint32_t busy_timeout,
                        uint16_t w, uint16_t h, GxEPD2::Panel p, bool c, bool pu, bool fpu) :
   WIDTH(w), HEIGHT(h), panel(p), hasColor(c), hasPartialUpdate(pu), hasFastPartialUpdate(fpu),
   _cs(cs), _dc(dc), _rst(rst), _busy(busy), _busy_level(busy_level), _busy_timeout(busy_timeout), _diag_enabled(false),
-  _spi_settings(4000000, MSBFIRST, SPI_MODE0)
+  _bus(&GxEPD2_hw_spi_bus), _spi_frequency(4000000), _spi_settings(4000000, MSBFIRST, SPI_MODE0)
 {
   _initial_write = true;
   _initial_refresh = true;
@@ -29,6 +31,18 @@ GxEPD2_EPD::GxEPD2_EPD(int8_t cs, int8_t dc, int8_t rst, int8_t busy, int8_t bus
   _using_partial_mode = false;
   _hibernating = false;
   _reset_duration = 20;
+  _session_depth = 0;
+  _async_mode = false;
+  _async_running = false;
+  _busy_pending = false;
+  _busy_stream = 0;
+  _async_state = AsyncIdle;
+  _async_then = AsyncNone;
+  _async_again.bitmap = 0;
+  _async_callback = 0;
+  _async_callback_p = 0;
+  resetStats();
+  setRecorder(0);
 }
 
 void GxEPD2_EPD::init(uint32_t serial_diag_bitrate)
@@ -38,6 +52,10 @@ void GxEPD2_EPD::init(uint32_t serial_diag_bitrate)
 
 void GxEPD2_EPD::init(uint32_t serial_diag_bitrate, bool initial, uint16_t reset_duration, bool pulldown_rst_mode)
 {
+  _busy_pending = false;
+  _busy_stream = 0;
+  _async_state = AsyncIdle;
+  _async_again.bitmap = 0;
   _initial_write = initial;
   _initial_refresh = initial;
   _pulldown_rst_mode = pulldown_rst_mode;
@@ -65,7 +83,36 @@ void GxEPD2_EPD::init(uint32_t serial_diag_bitrate, bool initial, uint16_t reset
   {
     pinMode(_busy, INPUT);
   }
-  SPI.begin();
+  _bus->begin();
+}
+
+void GxEPD2_EPD::setSpiFrequency(uint32_t frequency)
+{
+  _spi_frequency = frequency;
+  _spi_settings = SPISettings(frequency, MSBFIRST, SPI_MODE0);
+}
+
+uint32_t GxEPD2_EPD::probeSpiFrequency(uint32_t max_frequency)
+{
+  uint32_t frequency = _spi_frequency;
+  if (!_checkSpiWrite()) return frequency; // no readback check, or fails already
+  while (frequency < max_frequency)
+  {
+    uint32_t next = frequency < max_frequency / 2 ? frequency * 2 : max_frequency;
+    setSpiFrequency(next);
+    bool ok = true;
+    for (uint8_t i = 0; ok && (i < 3); i++) ok = _checkSpiWrite(); // repeat for some margin
+    if (!ok) break;
+    frequency = next;
+  }
+  setSpiFrequency(frequency); // back off
+#if !defined(DISABLE_DIAGNOSTIC_OUTPUT)
+  if (_diag_enabled)
+  {
+    Serial.print("SPI frequency : "); Serial.println(frequency);
+  }
+#endif
+  return frequency;
 }
 
 void GxEPD2_EPD::_reset()
@@ -96,6 +143,16 @@ void GxEPD2_EPD::_reset()
 
 void GxEPD2_EPD::_waitWhileBusy(const char* comment, uint16_t busy_time)
 {
+  if (_busy_pending) waitWhileBusy();
+  if (_async_mode)
+  {
+    // defer wait, completed by poll() or by next bus access
+    _busy_pending = true;
+    _busy_comment = comment;
+    _busy_time = busy_time;
+    _busy_start = micros();
+    return;
+  }
   if (_busy >= 0)
   {
     delay(1); // add some margin to become active
@@ -122,122 +179,768 @@ void GxEPD2_EPD::_waitWhileBusy(const char* comment, uint16_t busy_time)
       }
 #endif
     }
+    GxEPD2_STATS_ADD(busy_waits, 1);
+    GxEPD2_STATS_ADD(busy_time, (micros() - start) / 1000);
+    GxEPD2_RECORD(busy(start, micros() - start));
     (void) start;
   }
-  else delay(busy_time);
+  else
+  {
+    GxEPD2_RECORD(busy(micros(), 1000ul * busy_time));
+    delay(busy_time);
+    GxEPD2_STATS_ADD(busy_waits, 1);
+    GxEPD2_STATS_ADD(busy_time, busy_time);
+  }
 }
 
-void GxEPD2_EPD::_writeCommand(uint8_t c)
+bool GxEPD2_EPD::_busyReleased()
 {
-  SPI.beginTransaction(_spi_settings);
-  if (_dc >= 0) digitalWrite(_dc, LOW);
-  if (_cs >= 0) digitalWrite(_cs, LOW);
-  SPI.transfer(c);
-  if (_cs >= 0) digitalWrite(_cs, HIGH);
-  if (_dc >= 0) digitalWrite(_dc, HIGH);
-  SPI.endTransaction();
+  unsigned long elapsed = micros() - _busy_start;
+  if (_busy < 0) return elapsed >= 1000ul * _busy_time;
+  if (elapsed < 1000) return false; // add some margin to become active
+  if (digitalRead(_busy) != _busy_level) return true;
+  if (elapsed > _busy_timeout)
+  {
+    Serial.println("Busy Timeout!");
+    return true;
+  }
+  return false;
 }
 
-void GxEPD2_EPD::_writeData(uint8_t d)
+void GxEPD2_EPD::_endBusyWait()
 {
-  SPI.beginTransaction(_spi_settings);
-  if (_cs >= 0) digitalWrite(_cs, LOW);
-  SPI.transfer(d);
-  if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _busy_pending = false;
+  GxEPD2_STATS_ADD(busy_waits, 1);
+  GxEPD2_STATS_ADD(busy_time, (micros() - _busy_start) / 1000);
+  GxEPD2_RECORD(busy(_busy_start, micros() - _busy_start));
+#if !defined(DISABLE_DIAGNOSTIC_OUTPUT)
+  if (_busy_comment && _diag_enabled)
+  {
+    unsigned long elapsed = micros() - _busy_start;
+    Serial.print(_busy_comment);
+    Serial.print(" : ");
+    Serial.println(elapsed);
+  }
+#endif
 }
 
-void GxEPD2_EPD::_writeData(const uint8_t* data, uint16_t n)
+void GxEPD2_EPD::refreshAsync(bool partial_update_mode, AsyncAction then)
 {
-  SPI.beginTransaction(_spi_settings);
-  if (_cs >= 0) digitalWrite(_cs, LOW);
-  for (uint16_t i = 0; i < n; i++)
+  waitWhileBusy(); // complete previous
+  _async_mode = true;
+  refresh(partial_update_mode);
+  _async_mode = false;
+  _async_state = AsyncRefresh;
+  _async_then = then;
+}
+
+void GxEPD2_EPD::refreshAsync(int16_t x, int16_t y, int16_t w, int16_t h, AsyncAction then)
+{
+  waitWhileBusy(); // complete previous
+  _async_mode = true;
+  refresh(x, y, w, h);
+  _async_mode = false;
+  _async_state = AsyncRefresh;
+  _async_then = then;
+}
+
+void GxEPD2_EPD::writeImageAgainAsync(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  if (_async_state != AsyncRefresh) return writeImageAgain(bitmap, x, y, w, h, invert, mirror_y, pgm);
+  _async_again.bitmap = bitmap;
+  _async_again.part = false;
+  _async_again.x = x;
+  _async_again.y = y;
+  _async_again.w = w;
+  _async_again.h = h;
+  _async_again.invert = invert;
+  _async_again.mirror_y = mirror_y;
+  _async_again.pgm = pgm;
+}
+
+void GxEPD2_EPD::writeImagePartAgainAsync(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+    int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  if (_async_state != AsyncRefresh) return writeImagePartAgain(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+  writeImageAgainAsync(bitmap, x, y, w, h, invert, mirror_y, pgm);
+  _async_again.part = true;
+  _async_again.x_part = x_part;
+  _async_again.y_part = y_part;
+  _async_again.w_bitmap = w_bitmap;
+  _async_again.h_bitmap = h_bitmap;
+}
+
+// writeImageRotated(): pixel i, j of the image, at drawing x + i, y + j, is at panel
+//   rotation 1 : WIDTH - 1 - y - j, x + i, window h (padded to bytes) by w
+//   rotation 2 : WIDTH - 1 - x - i, HEIGHT - 1 - y - j, window w (padded to bytes) by h
+//   rotation 3 : y + j, HEIGHT - 1 - x - i, window h (padded to bytes) by w
+// with _startRotatedWrite() the controller gets the image in its own order, its address counter places the bytes:
+//   rotation 2 : image rows, bytes bit reversed; the address counter decreases in x and y
+//   rotation 1, 3 : one byte column of the window after the other, each byte of 8 image rows of a column through the 8x8 transpose;
+//   the address counter runs in y direction first, increasing for rotation 1, decreasing for rotation 3
+// else blocks of panel bytes are written with writeImage()
+
+static inline uint8_t _bitmapByte(const uint8_t* p, bool pgm)
+{
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+  return pgm ? pgm_read_byte(p) : *p;
+#else
+  return *p;
+#endif
+}
+
+static inline uint8_t _reverseBits(uint8_t b)
+{
+  b = (b >> 4) | (b << 4);
+  b = ((b & 0xCC) >> 2) | ((b & 0x33) << 2);
+  return ((b & 0xAA) >> 1) | ((b & 0x55) << 1);
+}
+
+// 8x8 bit transpose of rows MSB first, b[m] bit 7 - k is a[k] bit 7 - m (transpose8 of Hacker's Delight)
+static void _transpose8(const uint8_t* a, uint8_t* b)
+{
+  uint32_t x = (uint32_t(a[0]) << 24) | (uint32_t(a[1]) << 16) | (uint32_t(a[2]) << 8) | a[3];
+  uint32_t y = (uint32_t(a[4]) << 24) | (uint32_t(a[5]) << 16) | (uint32_t(a[6]) << 8) | a[7];
+  uint32_t t;
+  t = (x ^ (x >> 7)) & 0x00AA00AA;
+  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AA;
+  y = y ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC;
+  x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCC;
+  y = y ^ t ^ (t << 14);
+  t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+  y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+  x = t;
+  b[0] = x >> 24;
+  b[1] = x >> 16;
+  b[2] = x >> 8;
+  b[3] = x;
+  b[4] = y >> 24;
+  b[5] = y >> 16;
+  b[6] = y >> 8;
+  b[7] = y;
+}
+
+void GxEPD2_EPD::writeImageRotated(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, uint8_t rotation, bool invert, bool pgm)
+{
+  rotation &= 3;
+  if (0 == rotation) return writeImage(bitmap, x, y, w, h, invert, false, pgm);
+  if ((w <= 0) || (h <= 0)) return;
+  int16_t wb = (w + 7) / 8; // width bytes, bitmaps are padded
+  int16_t px, py, pw, ph; // panel window
+  switch (rotation)
   {
-    SPI.transfer(*data++);
+    case 1:
+      pw = 8 * ((h + 7) / 8);
+      ph = w;
+      px = int16_t(WIDTH) - y - pw;
+      py = x;
+      break;
+    case 2:
+      pw = 8 * wb;
+      ph = h;
+      px = int16_t(WIDTH) - x - pw;
+      py = int16_t(HEIGHT) - y - h;
+      break;
+    default:
+      pw = 8 * ((h + 7) / 8);
+      ph = w;
+      px = y;
+      py = int16_t(HEIGHT) - x - w;
+      break;
+  }
+  uint16_t pwb = pw / 8;
+  bool inside = (px >= 0) && (py >= 0) && (px + pw <= int16_t(WIDTH)) && (py + ph <= int16_t(HEIGHT)) && (0 == px % 8);
+  if (inside && _startRotatedWrite(rotation, px, py, pw, ph))
+  {
+    uint16_t n = 0;
+    _startTransfer();
+    if (2 == rotation)
+    {
+      for (int16_t j = 0; j < h; j++)
+      {
+        const uint8_t* row = bitmap + int32_t(j) * wb;
+        for (int16_t i = 0; i < wb; i++)
+        {
+          uint8_t data = _reverseBits(_bitmapByte(row + i, pgm));
+          _row_buffer[n++] = invert ? ~data : data;
+          if (n == sizeof(_row_buffer))
+          {
+            _transferRowBuffer(n);
+            n = 0;
+          }
+        }
+      }
+    }
+    else
+    {
+      uint8_t tile[8];
+      for (uint16_t ub = 0; ub < pwb; ub++)
+      {
+        for (int16_t ib = 0; ib < wb; ib++)
+        {
+          _rotatedTile(bitmap, wb, h, rotation, ub, ib, invert, pgm, tile);
+          uint8_t m_end = w - 8 * ib < 8 ? w - 8 * ib : 8; // columns of the image
+          for (uint8_t m = 0; m < m_end; m++)
+          {
+            _row_buffer[n++] = tile[m];
+            if (n == sizeof(_row_buffer))
+            {
+              _transferRowBuffer(n);
+              n = 0;
+            }
+          }
+        }
+      }
+    }
+    if (n > 0) _transferRowBuffer(n);
+    _endTransfer();
+    delay(1); // yield() to avoid WDT on ESP8266 and ESP32
+    return;
+  }
+  // in panel orientation, in blocks of bw bytes by bh rows; writeImage() clips to the panel
+  uint8_t block[GxEPD2_ROW_BUFFER_SIZE];
+  uint16_t bw = gx_uint16_min(pwb, gx_uint16_max(1, sizeof(block) / 8));
+  uint16_t bh = sizeof(block) / bw;
+  for (uint16_t c0 = 0; c0 < pwb; c0 += bw)
+  {
+    uint16_t cn = gx_uint16_min(bw, pwb - c0);
+    for (uint16_t v0 = 0; v0 < ph; v0 += bh)
+    {
+      uint16_t vn = gx_uint16_min(bh, ph - v0);
+      _fillRotatedBlock(block, bitmap, w, h, rotation, c0, cn, v0, vn, invert, pgm);
+      writeImage(block, px + 8 * c0, py + v0, 8 * cn, vn);
+    }
   }
-  if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
 }
 
-void GxEPD2_EPD::_writeDataPGM(const uint8_t* data, uint16_t n, int16_t fill_with_zeroes)
+// the 8 panel bytes of byte column ub of the window, for the image columns 8 * ib + m, m = 0..7, of rotation 1 or 3;
+// byte column ub holds 8 image rows, from the bottom for rotation 1, from the top for rotation 3; padding rows are white
+void GxEPD2_EPD::_rotatedTile(const uint8_t* bitmap, int16_t wb, int16_t h, uint8_t rotation, uint16_t ub, uint16_t ib, bool invert, bool pgm, uint8_t* tile)
 {
-  SPI.beginTransaction(_spi_settings);
-  if (_cs >= 0) digitalWrite(_cs, LOW);
-  for (uint16_t i = 0; i < n; i++)
+  uint8_t rows[8];
+  int16_t hp = 8 * ((h + 7) / 8);
+  for (uint8_t t = 0; t < 8; t++)
   {
-    SPI.transfer(pgm_read_byte(&*data++));
+    int16_t j = (1 == rotation) ? hp - 1 - 8 * int16_t(ub) - t : 8 * int16_t(ub) + t;
+    rows[t] = j < h ? _bitmapByte(bitmap + int32_t(j) * wb + ib, pgm) : (invert ? 0x00 : 0xFF);
   }
-  while (fill_with_zeroes > 0)
+  _transpose8(rows, tile);
+  if (invert)
   {
-    SPI.transfer(0x00);
-    fill_with_zeroes--;
+    for (uint8_t m = 0; m < 8; m++) tile[m] = ~tile[m];
   }
-  if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+}
+
+// panel bytes of byte columns c0 <= c < c0 + cn and rows v0 <= v < v0 + vn of the window of writeImageRotated(), cn bytes per row
+void GxEPD2_EPD::_fillRotatedBlock(uint8_t* block, const uint8_t* bitmap, int16_t w, int16_t h, uint8_t rotation,
+                                   uint16_t c0, uint16_t cn, uint16_t v0, uint16_t vn, bool invert, bool pgm)
+{
+  int16_t wb = (w + 7) / 8; // width bytes, bitmaps are padded
+  if (2 == rotation)
+  {
+    for (uint16_t v = 0; v < vn; v++)
+    {
+      const uint8_t* row = bitmap + int32_t(h - 1 - v0 - v) * wb + wb - 1 - c0;
+      for (uint16_t c = 0; c < cn; c++)
+      {
+        uint8_t data = _reverseBits(_bitmapByte(row - c, pgm));
+        block[v * cn + c] = invert ? ~data : data;
+      }
+    }
+    return;
+  }
+  // image columns is <= i < ie of the rows: i = v for rotation 1, i = w - 1 - v for rotation 3
+  int16_t is = (1 == rotation) ? v0 : w - v0 - vn;
+  int16_t ie = is + vn;
+  uint8_t tile[8];
+  for (uint16_t c = 0; c < cn; c++)
+  {
+    for (int16_t ib = is / 8; ib <= (ie - 1) / 8; ib++)
+    {
+      _rotatedTile(bitmap, wb, h, rotation, c0 + c, ib, invert, pgm, tile);
+      for (uint8_t m = 0; m < 8; m++)
+      {
+        int16_t i = 8 * ib + m;
+        if ((i < is) || (i >= ie)) continue;
+        uint16_t v = (1 == rotation) ? i : w - 1 - i;
+        block[(v - v0) * cn + c] = tile[m];
+      }
+    }
+  }
+}
+
+bool GxEPD2_EPD::poll()
+{
+  if (_async_running) return true; // called from follow-up action
+  while (true)
+  {
+    if (_busy_pending)
+    {
+      if (!_busyReleased()) return true;
+      _endBusyWait();
+      if (_busy_stream)
+      {
+        _continueStream();
+        continue;
+      }
+    }
+    if (_async_state == AsyncIdle) return false;
+    _async_running = true;
+    if (_async_state == AsyncRefresh)
+    {
+      if (_async_again.bitmap)
+      {
+        if (_async_again.part) writeImagePartAgain(_async_again.bitmap, _async_again.x_part, _async_again.y_part, _async_again.w_bitmap, _async_again.h_bitmap,
+              _async_again.x, _async_again.y, _async_again.w, _async_again.h, _async_again.invert, _async_again.mirror_y, _async_again.pgm);
+        else writeImageAgain(_async_again.bitmap, _async_again.x, _async_again.y, _async_again.w, _async_again.h, _async_again.invert, _async_again.mirror_y, _async_again.pgm);
+        _async_again.bitmap = 0;
+      }
+      if (_async_then != AsyncNone)
+      {
+        _async_state = _async_then == AsyncHibernate ? AsyncHibernating : AsyncPoweringOff;
+        _async_mode = true;
+        powerOff();
+        _async_mode = false;
+      }
+      else _async_state = AsyncIdle;
+    }
+    else
+    {
+      if (_async_state == AsyncHibernating) hibernate(); // power is off, enters deep sleep
+      _async_state = AsyncIdle;
+    }
+    _async_running = false;
+    if ((_async_state == AsyncIdle) && !_busy_pending)
+    {
+      if (_async_callback) _async_callback(_async_callback_p);
+      return false;
+    }
+  }
+}
+
+bool GxEPD2_EPD::isBusy()
+{
+  return _busy_pending || (_async_state != AsyncIdle);
+}
+
+void GxEPD2_EPD::waitWhileBusy()
+{
+  if (_async_running)
+  {
+    // bus access from follow-up action, complete deferred wait and command stream only
+    while (_busy_pending)
+    {
+      while (!_busyReleased()) delay(1);
+      _endBusyWait();
+      _continueStream();
+    }
+    return;
+  }
+  while (poll())
+  {
+    delay(1); // yield() to avoid WDT on ESP8266 and ESP32
+  }
+}
+
+void GxEPD2_EPD::setAsyncCallback(void (*callback)(void*), void* p)
+{
+  _async_callback = callback;
+  _async_callback_p = p;
+}
+
+GxEPD2_Stats GxEPD2_EPD::getStats()
+{
+#if ENABLE_GxEPD2_STATS
+  return _stats;
+#else
+  GxEPD2_Stats stats;
+  memset(&stats, 0, sizeof(stats));
+  return stats;
+#endif
+}
+
+void GxEPD2_EPD::resetStats()
+{
+#if ENABLE_GxEPD2_STATS
+  memset(&_stats, 0, sizeof(_stats));
+#endif
+}
+
+void GxEPD2_EPD::setRecorder(GxEPD2_Recorder* recorder)
+{
+#if ENABLE_GxEPD2_RECORDER
+  _recorder = recorder;
+#endif
+}
+
+void GxEPD2_EPD::_writeCommand(uint8_t c)
+{
+  _startTransfer();
+  _setDC(false);
+  _bus->transfer(c);
+  GxEPD2_STATS_ADD(commands, 1);
+  GxEPD2_RECORD(command(c));
+  _setDC(true);
+  _endTransfer();
+}
+
+void GxEPD2_EPD::_writeData(uint8_t d)
+{
+  _startTransfer();
+  _bus->transfer(d);
+  GxEPD2_STATS_ADD(data_bytes, 1);
+  GxEPD2_RECORD(data(d));
+  _endTransfer();
+}
+
+void GxEPD2_EPD::_writeData(const uint8_t* data, uint16_t n)
+{
+  _startTransfer();
+  _transferRow(data, n);
+  _endTransfer();
+}
+
+void GxEPD2_EPD::_writeDataPGM(const uint8_t* data, uint16_t n, int16_t fill_with_zeroes)
+{
+  _startTransfer();
+  _transferRow(data, n, false, true);
+  if (fill_with_zeroes > 0) _transferFill(0x00, fill_with_zeroes);
+  _endTransfer();
 }
 
 void GxEPD2_EPD::_writeDataPGM_sCS(const uint8_t* data, uint16_t n, int16_t fill_with_zeroes)
 {
-  SPI.beginTransaction(_spi_settings);
+  if (_busy_pending || ((_async_state != AsyncIdle) && !_async_running)) waitWhileBusy();
+  if (_session_depth == 0)
+  {
+    _bus->beginTransaction(_spi_settings);
+    GxEPD2_STATS_ADD(transactions, 1);
+  }
+  GxEPD2_STATS_ADD(data_bytes, n + (fill_with_zeroes > 0 ? fill_with_zeroes : 0));
+  GxEPD2_STATS_ADD(cs_toggles, n + (fill_with_zeroes > 0 ? fill_with_zeroes : 0));
   for (uint8_t i = 0; i < n; i++)
   {
     if (_cs >= 0) digitalWrite(_cs, LOW);
-    SPI.transfer(pgm_read_byte(&*data++));
+    uint8_t d = pgm_read_byte(&*data++);
+    _bus->transfer(d);
+    GxEPD2_RECORD(data(d));
     if (_cs >= 0) digitalWrite(_cs, HIGH);
   }
   while (fill_with_zeroes > 0)
   {
     if (_cs >= 0) digitalWrite(_cs, LOW);
-    SPI.transfer(0x00);
+    _bus->transfer(0x00);
+    GxEPD2_RECORD(data(0x00));
     fill_with_zeroes--;
     if (_cs >= 0) digitalWrite(_cs, HIGH);
   }
-  SPI.endTransaction();
+  if (_session_depth == 0) _bus->endTransaction();
+  else if (_cs >= 0) digitalWrite(_cs, LOW); // session keeps CS asserted
 }
 
 void GxEPD2_EPD::_writeCommandData(const uint8_t* pCommandData, uint8_t datalen)
 {
-  SPI.beginTransaction(_spi_settings);
-  if (_dc >= 0) digitalWrite(_dc, LOW);
-  if (_cs >= 0) digitalWrite(_cs, LOW);
-  SPI.transfer(*pCommandData++);
-  if (_dc >= 0) digitalWrite(_dc, HIGH);
-  for (uint8_t i = 0; i < datalen - 1; i++)  // sub the command
+  _startTransfer();
+  _setDC(false);
+  uint8_t c = *pCommandData++;
+  _bus->transfer(c);
+  GxEPD2_STATS_ADD(commands, 1);
+  GxEPD2_RECORD(command(c));
+  _setDC(true);
+  if (datalen > 1) _transferRow(pCommandData, datalen - 1); // sub the command
+  _endTransfer();
+}
+
+void GxEPD2_EPD::_writeCommandDataPGM(const uint8_t* pCommandData, uint8_t datalen)
+{
+  _startTransfer();
+  _setDC(false);
+  uint8_t c = pgm_read_byte(&*pCommandData++);
+  _bus->transfer(c);
+  GxEPD2_STATS_ADD(commands, 1);
+  GxEPD2_RECORD(command(c));
+  _setDC(true);
+  if (datalen > 1) _transferRow(pCommandData, datalen - 1, false, true); // sub the command
+  _endTransfer();
+}
+
+void GxEPD2_EPD::_writeCommandStream(const uint8_t* stream, const char* comment)
+{
+  _startTransfer();
+  while (true)
   {
-    SPI.transfer(*pCommandData++);
+    uint8_t count = pgm_read_byte(stream++);
+    if (count == 0xFF) break; // GxEPD2_END
+    if (count == 0xFD) // GxEPD2_BUSY
+    {
+      uint16_t busy_time = pgm_read_byte(stream) | (pgm_read_byte(stream + 1) << 8);
+      stream += 2;
+      _endTransfer();
+      _waitWhileBusy(comment, busy_time);
+      if (_busy_pending) // async mode, deferred wait
+      {
+        if (pgm_read_byte(stream) != 0xFF) _busy_stream = stream;
+        return;
+      }
+      _startTransfer();
+    }
+    else if (count == 0xFE) // GxEPD2_DELAY
+    {
+      _endTransfer();
+      delay(pgm_read_byte(stream++));
+      _startTransfer();
+    }
+    else
+    {
+      _setDC(false);
+      uint8_t c = pgm_read_byte(stream++);
+      _bus->transfer(c);
+      GxEPD2_STATS_ADD(commands, 1);
+      GxEPD2_RECORD(command(c));
+      _setDC(true);
+      _transferRow(stream, count, false, true);
+      stream += count;
+    }
   }
-  if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _endTransfer();
 }
 
-void GxEPD2_EPD::_writeCommandDataPGM(const uint8_t* pCommandData, uint8_t datalen)
+// sends the rest of a command stream that ended at a busy wait in async mode, may end at the next busy wait
+void GxEPD2_EPD::_continueStream()
 {
-  SPI.beginTransaction(_spi_settings);
-  if (_dc >= 0) digitalWrite(_dc, LOW);
-  if (_cs >= 0) digitalWrite(_cs, LOW);
-  SPI.transfer(pgm_read_byte(&*pCommandData++));
-  if (_dc >= 0) digitalWrite(_dc, HIGH);
-  for (uint8_t i = 0; i < datalen - 1; i++)  // sub the command
+  const uint8_t* stream = _busy_stream;
+  if (!stream) return;
+  _busy_stream = 0;
+  bool async_mode = _async_mode, async_running = _async_running;
+  _async_mode = true;
+  _async_running = true;
+  _writeCommandStream(stream, _busy_comment);
+  _async_mode = async_mode;
+  _async_running = async_running;
+}
+
+void GxEPD2_EPD::_readController(uint8_t cmd, uint8_t* data, uint16_t n)
+{
+  _startTransfer();
+  _setDC(false);
+  _bus->transfer(cmd);
+  GxEPD2_STATS_ADD(commands, 1);
+  GxEPD2_RECORD(command(cmd));
+  _setDC(true);
+  _bus->endTransaction(); // keep CS asserted
+  _bus->end();
+  int8_t sck = _bus->sckPin();
+  int8_t mosi = _bus->mosiPin();
+  if ((sck < 0) || (mosi < 0)) // transport without pins, e.g. GxEPD2_MockSpi
   {
-    SPI.transfer(pgm_read_byte(&*pCommandData++));
+    memset(data, 0, n);
+    if (_cs >= 0) digitalWrite(_cs, HIGH);
+    _bus->begin();
+    return;
+  }
+  pinMode(mosi, INPUT);
+  digitalWrite(sck, HIGH);
+  pinMode(sck, OUTPUT);
+  for (uint16_t j = 0; j < n; j++)
+  {
+    uint8_t value = 0;
+    for (uint16_t i = 0; i < 8; i++)
+    {
+      digitalWrite(sck, LOW);
+      value <<= 1;
+      delayMicroseconds(2);
+      if (digitalRead(mosi)) value |= 0x01;
+      delayMicroseconds(2);
+      digitalWrite(sck, HIGH);
+      delayMicroseconds(2);
+    }
+    data[j] = value;
   }
   if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  pinMode(sck, INPUT);
+  _bus->begin();
 }
 
 void GxEPD2_EPD::_startTransfer()
 {
-  SPI.beginTransaction(_spi_settings);
+  if (_busy_pending || ((_async_state != AsyncIdle) && !_async_running)) waitWhileBusy();
+  if (_session_depth > 0) return; // bus is held by session
+  _bus->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
+  GxEPD2_STATS_ADD(transactions, 1);
+  GxEPD2_STATS_ADD(cs_toggles, 1);
 }
 
 void GxEPD2_EPD::_transfer(uint8_t value)
 {
-  SPI.transfer(value);
+  _bus->transfer(value);
+  GxEPD2_STATS_ADD(data_bytes, 1);
+  GxEPD2_RECORD(data(value));
 }
 
 void GxEPD2_EPD::_endTransfer()
 {
+  if (_session_depth > 0) return; // bus is held by session
   if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _bus->endTransaction();
+}
+
+void GxEPD2_EPD::_beginSession()
+{
+  if (_busy_pending || ((_async_state != AsyncIdle) && !_async_running)) waitWhileBusy();
+  if (_session_depth == 0)
+  {
+    _bus->beginTransaction(_spi_settings);
+    if (_cs >= 0) digitalWrite(_cs, LOW);
+    GxEPD2_STATS_ADD(transactions, 1);
+    GxEPD2_STATS_ADD(cs_toggles, 1);
+  }
+  _session_depth++;
+}
+
+void GxEPD2_EPD::_endSession()
+{
+  if (_session_depth == 0) return;
+  _session_depth--;
+  if (_session_depth == 0)
+  {
+    if (_cs >= 0) digitalWrite(_cs, HIGH);
+    _bus->endTransaction();
+  }
+}
+
+void GxEPD2_EPD::_transferRow(const uint8_t* row, uint16_t n, bool invert, bool pgm)
+{
+  while (n > 0)
+  {
+    uint16_t chunk = n < sizeof(_row_buffer) ? n : sizeof(_row_buffer);
+    if (pgm)
+    {
+      for (uint16_t i = 0; i < chunk; i++)
+      {
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+        _row_buffer[i] = pgm_read_byte(&row[i]);
+#else
+        _row_buffer[i] = row[i];
+#endif
+      }
+    }
+    else memcpy(_row_buffer, row, chunk);
+    if (invert)
+    {
+      for (uint16_t i = 0; i < chunk; i++) _row_buffer[i] = ~_row_buffer[i];
+    }
+    _transferRowBuffer(chunk);
+    row += chunk;
+    n -= chunk;
+  }
+}
+
+void GxEPD2_EPD::_transferRows(const uint8_t* bitmap, int16_t wb, int16_t h_bitmap, int16_t x_byte, int16_t y_row, uint16_t n, uint16_t rows,
+                               bool invert, bool mirror_y, bool pgm)
+{
+  if ((n == 0) || (rows == 0)) return;
+  int32_t row = mirror_y ? h_bitmap - 1 - y_row : y_row;
+  const uint8_t* first = bitmap + x_byte + row * wb;
+  int32_t stride = mirror_y ? -int32_t(wb) : wb;
+  // the flags select the copy loop once per window, not per byte
+  if (invert)
+  {
+    if (pgm) _transferRowsT<true, true>(first, stride, n, rows);
+    else _transferRowsT<true, false>(first, stride, n, rows);
+  }
+  else
+  {
+    if (pgm) _transferRowsT<false, true>(first, stride, n, rows);
+    else _transferRowsT<false, false>(first, stride, n, rows);
+  }
+}
+
+template <bool invert, bool pgm> void GxEPD2_EPD::_transferRowsT(const uint8_t* row, int32_t stride, uint16_t n, uint16_t rows)
+{
+  uint16_t used = 0; // bytes in row buffer
+  for (; rows > 0; rows--, row += stride)
+  {
+    const uint8_t* p = row;
+    uint16_t remaining = n;
+    while (remaining > 0)
+    {
+      uint16_t chunk = remaining < sizeof(_row_buffer) - used ? remaining : sizeof(_row_buffer) - used;
+      uint8_t* q = _row_buffer + used;
+      if (!invert && !pgm) memcpy(q, p, chunk);
+      else
+      {
+        for (uint16_t i = 0; i < chunk; i++)
+        {
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+          uint8_t data = pgm ? pgm_read_byte(&p[i]) : p[i];
+#else
+          uint8_t data = p[i];
+#endif
+          q[i] = invert ? ~data : data;
+        }
+      }
+      used += chunk;
+      p += chunk;
+      remaining -= chunk;
+      if (used == sizeof(_row_buffer))
+      {
+        _transferRowBuffer(used);
+        used = 0;
+      }
+    }
+  }
+  if (used > 0) _transferRowBuffer(used);
+}
+
+void GxEPD2_EPD::_transferFill(uint8_t value, uint32_t n)
+{
+  while (n > 0)
+  {
+    uint16_t chunk = n < sizeof(_row_buffer) ? n : sizeof(_row_buffer);
+    memset(_row_buffer, value, chunk); // refill, writeBytes may overwrite buffer
+    _transferRowBuffer(chunk);
+    n -= chunk;
+  }
+}
+
+// packs bit 1 (or bit 0, shifted up) of the 4 pixels of a grey byte into the high nibble
+static inline uint8_t _greyNibble(uint8_t value, uint8_t bit)
+{
+  uint8_t b = (bit ? value : value << 1) & 0xAA;
+  b = (b | (b << 1)) & 0xCC;
+  return (b | (b << 2)) & 0xF0;
+}
+
+void GxEPD2_EPD::_transferGreyPlane(const uint8_t* row, uint16_t n, uint8_t bit, bool invert, bool pgm)
+{
+  while (n > 0)
+  {
+    uint16_t chunk = n < sizeof(_row_buffer) ? n : sizeof(_row_buffer);
+    for (uint16_t i = 0; i < chunk; i++)
+    {
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+      uint8_t hi = pgm ? pgm_read_byte(&row[2 * i]) : row[2 * i];
+      uint8_t lo = pgm ? pgm_read_byte(&row[2 * i + 1]) : row[2 * i + 1];
+#else
+      uint8_t hi = row[2 * i];
+      uint8_t lo = row[2 * i + 1];
+#endif
+      uint8_t data = _greyNibble(hi, bit) | (_greyNibble(lo, bit) >> 4);
+      _row_buffer[i] = invert ? ~data : data;
+    }
+    _transferRowBuffer(chunk);
+    row += 2 * chunk;
+    n -= chunk;
+  }
+}
+
+void GxEPD2_EPD::_transferRowBuffer(uint16_t n)
+{
+  GxEPD2_RECORD(data(_row_buffer, n)); // before write, buffer may be overwritten
+  _bus->writeBytes(_row_buffer, n); // may overwrite buffer with received data
+  GxEPD2_STATS_ADD(data_bytes, n);
 }
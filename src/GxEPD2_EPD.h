@@ -16,9 +16,99 @@
 #include <SPI.h>
 
 #include <GxEPD2.h>
+#include <GxEPD2_Transport.h>
+#include <GxEPD2_Recorder.h>
 
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 
+// size of the row buffer used for block transfers, rows longer than this are sent in chunks
+#ifndef GxEPD2_ROW_BUFFER_SIZE
+#if defined(__AVR)
+#define GxEPD2_ROW_BUFFER_SIZE 16
+#else
+#define GxEPD2_ROW_BUFFER_SIZE 128 // fits a full row of 1024 pixels
+#endif
+#endif
+
+// command streams for GxEPD2_EPD::_writeCommandStream(), PROGMEM byte arrays built at compile time, e.g.
+// static const uint8_t init[] PROGMEM = {GxEPD2_CMD(0x00, 0x1f), GxEPD2_CMD(0x04), GxEPD2_BUSY(100), GxEPD2_END};
+// GxEPD2_CMD(command, data...) : count, command, data[count], count is at most 0xFC, checked at compile time
+#define GxEPD2_CMD(...) GxEPD2_CmdCount<GxEPD2_count(__VA_ARGS__)>::value, __VA_ARGS__
+#define GxEPD2_BUSY(busy_time) 0xFD, uint8_t((busy_time) & 0xFF), uint8_t((busy_time) >> 8) // wait while busy
+#define GxEPD2_DELAY(ms) 0xFE, uint8_t(ms) // delay, max 255ms
+#define GxEPD2_END 0xFF
+
+// transfer and busy time statistics, see GxEPD2_EPD::getStats()
+#ifndef ENABLE_GxEPD2_STATS
+// default is off, compiles out
+#define ENABLE_GxEPD2_STATS 0
+#endif
+
+#if ENABLE_GxEPD2_STATS
+#define GxEPD2_STATS_ADD(counter, n) _stats.counter += (n)
+#else
+#define GxEPD2_STATS_ADD(counter, n)
+#endif
+
+// command stream recorder, see GxEPD2_Recorder.h
+#ifndef ENABLE_GxEPD2_RECORDER
+// default is off, compiles out
+#define ENABLE_GxEPD2_RECORDER 0
+#endif
+
+#if ENABLE_GxEPD2_RECORDER
+#define GxEPD2_RECORD(event) if (_recorder) _recorder->event
+#else
+#define GxEPD2_RECORD(event)
+#endif
+
+// GxEPD2_BW and GxEPD2_3C keep a hash per band of rows of the last frame sent with display() or nextPage(), full window;
+// unchanged frames are not refreshed, unchanged pages of paged full window drawing are not written,
+// display(true) with full screen buffer writes and refreshes only changed bands, see GxEPD2_RowHash.h
+#ifndef ENABLE_GxEPD2_ROW_HASH
+// default is off, compiles out
+#define ENABLE_GxEPD2_ROW_HASH 0
+#endif
+
+// rows per band, 4 bytes per band
+#ifndef GxEPD2_ROW_HASH_BAND
+#define GxEPD2_ROW_HASH_BAND 8
+#endif
+
+// GxEPD2_BW, GxEPD2_3C and GxEPD2_7C skip characters outside the current page in write(), e.g. with print() in paged drawing;
+// needs textsize_x of Adafruit_GFX 1.5 or later
+#ifndef ENABLE_GxEPD2_TEXT_CULLING
+#if defined(PARTICLE) // Adafruit_GFX_RK
+#define ENABLE_GxEPD2_TEXT_CULLING 0
+#else
+#define ENABLE_GxEPD2_TEXT_CULLING 1
+#endif
+#endif
+
+struct GxEPD2_Stats
+{
+  uint32_t commands;
+  uint32_t data_bytes;
+  uint32_t transactions;
+  uint32_t cs_toggles; // CS assertions
+  uint32_t busy_waits;
+  uint32_t busy_time; // ms
+  uint32_t full_refreshes;
+  uint32_t partial_refreshes;
+};
+
+template <typename... T> constexpr uint16_t GxEPD2_count(T...)
+{
+  return sizeof...(T);
+}
+
+// count byte of GxEPD2_CMD() with n arguments, command and data; 0xFD..0xFF are the markers
+template <uint16_t n> struct GxEPD2_CmdCount
+{
+  static_assert((n >= 1) && (n - 1 <= 0xFC), "GxEPD2_CMD: at most 0xFC data bytes");
+  static const uint8_t value = n - 1;
+};
+
 class GxEPD2_EPD
 {
   public:
@@ -68,6 +158,10 @@ class GxEPD2_EPD
       // most controllers with differential update do switch buffers on refresh, can use:
       writeImagePart(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
+    // write a bitmap in drawing orientation of rotation 0..3 (as Adafruit_GFX::setRotation()) to controller memory, without screen refresh,
+    // at x, y in drawing coordinates, where GxEPD2_BW would draw it; the controller does the transform if the driver supports it,
+    // else quarter turns go through an 8x8 bit transpose; x and w should be multiple of 8 for rotation 0 or 2, y and h for rotation 1 or 3
+    void writeImageRotated(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, uint8_t rotation, bool invert = false, bool pgm = false);
     // write to controller memory, with screen refresh; x and w should be multiple of 8
     //    virtual void drawImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false) = 0;
     //    virtual void drawImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
@@ -82,6 +176,49 @@ class GxEPD2_EPD
     virtual void powerOff() = 0; // turns off generation of panel driving voltages, avoids screen fading over time
     virtual void hibernate() = 0; // turns powerOff() and sets controller to deep sleep for minimum power use, ONLY if wakeable by RST (rst >= 0)
     virtual void setPaged() {}; // for GxEPD2_154c paged workaround
+    // SPI clock for writes, default 4MHz; most controllers accept faster writes, e.g. 10MHz or 20MHz
+    virtual void setSpiFrequency(uint32_t frequency);
+    uint32_t getSpiFrequency()
+    {
+      return _spi_frequency;
+    };
+    // raises SPI clock until write and readback check fails, then backs off to last good value, returns SPI clock used
+    // keeps the current SPI clock if the driver has no readback check (or it fails at the current SPI clock)
+    // call after init(), overwrites some controller memory, use before writing content
+    uint32_t probeSpiFrequency(uint32_t max_frequency = 20000000);
+    // asynchronous refresh: starts the refresh and returns without waiting while busy
+    // the refresh and the queued follow-up actions are completed by calling poll() until it returns false
+    // other methods called while an asynchronous refresh is in progress complete it first (blocking)
+    enum AsyncAction {AsyncNone, AsyncPowerOff, AsyncHibernate}; // follow-up action after refresh
+    void refreshAsync(bool partial_update_mode = false, AsyncAction then = AsyncNone);
+    void refreshAsync(int16_t x, int16_t y, int16_t w, int16_t h, AsyncAction then = AsyncNone);
+    // queue second phase write for differential update, done by poll() after refresh, bitmap must stay valid until then
+    void writeImageAgainAsync(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void writeImagePartAgainAsync(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                                  int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    bool poll(); // advances asynchronous refresh, returns true while in progress
+    bool isBusy(); // asynchronous refresh in progress, doesn't advance
+    void waitWhileBusy(); // completes asynchronous refresh (blocking)
+    // completion callback, called from poll() when asynchronous refresh and follow-up actions are done
+    void setAsyncCallback(void (*callback)(void*), void* p = 0);
+    // statistics, counted only if compiled with ENABLE_GxEPD2_STATS 1, all zero otherwise
+    GxEPD2_Stats getStats();
+    void resetStats();
+    // records commands, data and busy waits, only if compiled with ENABLE_GxEPD2_RECORDER 1; 0 to stop recording
+    void setRecorder(GxEPD2_Recorder* recorder);
+    // bus transport, GxEPD2_HwSpi if not set; the display templates set the bus of their transport parameter, see GxEPD2_Transport.h
+    void setBus(GxEPD2_Bus& bus)
+    {
+      _bus = &bus;
+    };
+    GxEPD2_Bus& bus()
+    {
+      return *_bus;
+    };
+    int8_t busyPin() // e.g. for attachInterrupt() to wake up on refresh end
+    {
+      return _busy;
+    };
     static inline uint16_t gx_uint16_min(uint16_t a, uint16_t b)
     {
       return (a < b ? a : b);
@@ -93,6 +230,21 @@ class GxEPD2_EPD
   protected:
     void _reset();
     void _waitWhileBusy(const char* comment = 0, uint16_t busy_time = 5000);
+    bool _busyReleased();
+    void _endBusyWait();
+    void _statsRefresh(bool partial_update_mode)
+    {
+#if ENABLE_GxEPD2_STATS
+      if (partial_update_mode) _stats.partial_refreshes++;
+      else _stats.full_refreshes++;
+#endif
+    };
+    // DC line, command (false) or data (true), also to the transport, e.g. for the hash of GxEPD2_MockSpi
+    void _setDC(bool data)
+    {
+      if (_dc >= 0) digitalWrite(_dc, data ? HIGH : LOW);
+      _bus->setDC(data);
+    };
     void _writeCommand(uint8_t c);
     void _writeData(uint8_t d);
     void _writeData(const uint8_t* data, uint16_t n);
@@ -100,17 +252,97 @@ class GxEPD2_EPD
     void _writeDataPGM_sCS(const uint8_t* data, uint16_t n, int16_t fill_with_zeroes = 0);
     void _writeCommandData(const uint8_t* pCommandData, uint8_t datalen);
     void _writeCommandDataPGM(const uint8_t* pCommandData, uint8_t datalen);
+    // sends a command stream from PROGMEM with CS asserted throughout, except for busy waits and delays;
+    // in async mode the stream ends at a busy wait, the rest is sent by poll() when no longer busy, or by the next bus access
+    void _writeCommandStream(const uint8_t* stream, const char* comment = 0);
     void _startTransfer();
     void _transfer(uint8_t value);
     void _endTransfer();
+    // 3-wire SPI read, the controller drives the data line (MOSI), bit-banged at low clock; don't use inside a BusSession
+    void _readController(uint8_t cmd, uint8_t* data, uint16_t n);
+    // writes a test pattern at current SPI clock and reads it back, for probeSpiFrequency(); false if not supported
+    // implementations set _initial_write, as the pattern overwrites controller memory
+    virtual bool _checkSpiWrite()
+    {
+      return false;
+    };
+    // controller side transform for writeImageRotated(): starts the write of the RAM window x, y, w, h in panel coordinates,
+    // with the address counter running in the order of rotation 1, 2 or 3 (see GxEPD2_EPD.cpp); false if not supported
+    virtual bool _startRotatedWrite(uint8_t rotation, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+      return false;
+    };
+    // bus session: keeps SPI transaction and CS asserted across a group of commands and data, only DC toggles
+    // use as local object: BusSession session(*this); sessions may nest; don't wait while busy inside a session
+    class BusSession
+    {
+      public:
+        BusSession(GxEPD2_EPD& epd) : _epd(epd)
+        {
+          _epd._beginSession();
+        }
+        ~BusSession()
+        {
+          _epd._endSession();
+        }
+      private:
+        GxEPD2_EPD& _epd;
+    };
+    void _beginSession();
+    void _endSession();
+    // block transfer, use between _startTransfer() and _endTransfer(), or inside a BusSession
+    void _transferRow(const uint8_t* row, uint16_t n, bool invert = false, bool pgm = false); // staged through row buffer
+    // rows of a bitmap window for _writeImage() and _writeImagePart() of the drivers: rows of n bytes, from byte x_byte of row y_row
+    // of a bitmap of wb bytes per row and h_bitmap rows, counted from the bottom if mirror_y; rows are packed into full row buffers
+    void _transferRows(const uint8_t* bitmap, int16_t wb, int16_t h_bitmap, int16_t x_byte, int16_t y_row, uint16_t n, uint16_t rows,
+                       bool invert = false, bool mirror_y = false, bool pgm = false);
+    void _transferFill(uint8_t value, uint32_t n);
+    // one bit plane of a row of 2 bit grey pixels, 4 pixels per byte, first pixel in the high bits (see GxEPD2_4G.h):
+    // n plane bytes from 2 * n row bytes, bit 1 or bit 0 of each pixel, staged through row buffer
+    void _transferGreyPlane(const uint8_t* row, uint16_t n, uint8_t bit, bool invert = false, bool pgm = false);
+  private:
+    void _continueStream();
+    void _transferRowBuffer(uint16_t n);
+    template <bool invert, bool pgm> void _transferRowsT(const uint8_t* row, int32_t stride, uint16_t n, uint16_t rows);
+    void _rotatedTile(const uint8_t* bitmap, int16_t wb, int16_t h, uint8_t rotation, uint16_t ub, uint16_t ib, bool invert, bool pgm, uint8_t* tile);
+    void _fillRotatedBlock(uint8_t* block, const uint8_t* bitmap, int16_t w, int16_t h, uint8_t rotation,
+                           uint16_t c0, uint16_t cn, uint16_t v0, uint16_t vn, bool invert, bool pgm);
   protected:
     int8_t _cs, _dc, _rst, _busy, _busy_level;
     uint32_t _busy_timeout;
     bool _diag_enabled, _pulldown_rst_mode;
+    GxEPD2_Bus* _bus;
+    uint32_t _spi_frequency;
     SPISettings _spi_settings;
     bool _initial_write, _initial_refresh;
     bool _power_is_on, _using_partial_mode, _hibernating;
     uint16_t _reset_duration;
+    // asynchronous refresh
+    enum AsyncState {AsyncIdle, AsyncRefresh, AsyncPoweringOff, AsyncHibernating};
+    bool _async_mode, _async_running, _busy_pending;
+    AsyncState _async_state;
+    AsyncAction _async_then;
+    const char* _busy_comment;
+    const uint8_t* _busy_stream; // rest of the command stream after the pending busy wait
+    uint16_t _busy_time;
+    unsigned long _busy_start;
+    struct
+    {
+      const uint8_t* bitmap;
+      int16_t x_part, y_part, w_bitmap, h_bitmap, x, y, w, h;
+      bool part, invert, mirror_y, pgm;
+    } _async_again;
+    void (*_async_callback)(void*);
+    void* _async_callback_p;
+#if ENABLE_GxEPD2_STATS
+    GxEPD2_Stats _stats;
+#endif
+#if ENABLE_GxEPD2_RECORDER
+    GxEPD2_Recorder* _recorder;
+#endif
+  private:
+    uint8_t _session_depth;
+    uint8_t _row_buffer[GxEPD2_ROW_BUFFER_SIZE];
 };
 
 #endif
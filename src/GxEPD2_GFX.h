@@ -41,6 +41,9 @@ class GxEPD2_GFX : public GxEPD2_GFX_ROOT_CLASS
     virtual void fillScreen(uint16_t color) = 0; // 0x0 black, >0x0 white, to buffer
     // display buffer content to screen, useful for full screen buffer
     virtual void display(bool partial_update_mode = false) = 0;
+    // asynchronous display(): returns while the screen refreshes, call poll() until it returns false
+    virtual void displayAsync(bool partial_update_mode = false) = 0;
+    virtual bool poll() = 0; // advances asynchronous display, returns true while in progress
     // display part of buffer content to screen, useful for full screen buffer
     // displayWindow, use parameters according to actual rotation.
     // x and w should be multiple of 8, for rotation 0 or 2,
@@ -58,6 +61,9 @@ class GxEPD2_GFX : public GxEPD2_GFX_ROOT_CLASS
     virtual void firstPage() = 0;
     virtual bool nextPage() = 0;
     virtual void drawPaged(void (*drawCallback)(const void*), const void* pv) = 0;
+    // bounds of the current page in drawing coordinates, e.g. for drawPaged() callbacks to skip whole widgets outside
+    virtual void getPageBounds(int16_t& x, int16_t& y, int16_t& w, int16_t& h) = 0;
+    virtual bool pageIntersects(int16_t x, int16_t y, int16_t w, int16_t h) = 0; // true if the rectangle is (partly) on the current page
     virtual void drawInvertedBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color) = 0;
     //  Support for Bitmaps (Sprites) to Controller Buffer and to Screen
     virtual void clearScreen(uint8_t value = 0xFF) = 0; // init controller memory and screen (default white)
@@ -0,0 +1,83 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// GxEPD2_MockSpi : bus transport that records traffic, no bus access, for benchmarks and tests on a host, see GxEPD2_Transport.h
+// no dependency on Arduino headers, also used by the host replay tool in extras/replay, so both count and hash the same way
+
+#ifndef _GxEPD2_MockSpi_H_
+#define _GxEPD2_MockSpi_H_
+
+#include <stdint.h>
+
+class GxEPD2_MockSpi
+{
+  public:
+    // traffic counters and FNV-1a hash of all bytes written, commands tagged as 0x100 | command, see setDC()
+    uint32_t bytes, commands, transactions, hash;
+    GxEPD2_MockSpi() : bytes(0), commands(0), transactions(0), hash(2166136261ul), _dc_tag(0), _recorder(0), _recorder_p(0) {};
+    // optional recorder, called for each byte written, with the tag: 0x100 | command or data
+    void setRecorder(void (*recorder)(uint16_t tagged, void* p), void* p = 0)
+    {
+      _recorder = recorder;
+      _recorder_p = p;
+    };
+    void reset()
+    {
+      bytes = 0;
+      commands = 0;
+      transactions = 0;
+      hash = 2166136261ul;
+      _dc_tag = 0;
+    };
+    // state of the DC line for the following bytes, command (false) or data (true)
+    void setDC(bool data)
+    {
+      _dc_tag = data ? 0 : 0x100;
+    };
+    void begin()
+    {
+    };
+    void end()
+    {
+    };
+    template <class Settings> void beginTransaction(const Settings& settings)
+    {
+      transactions++;
+    };
+    void endTransaction()
+    {
+    };
+    uint8_t transfer(uint8_t data)
+    {
+      uint16_t tagged = _dc_tag | data;
+      bytes++;
+      if (_dc_tag) commands++;
+      hash = (hash ^ tagged) * 16777619ul;
+      if (_recorder) _recorder(tagged, _recorder_p);
+      return 0;
+    };
+    void writeBytes(uint8_t* data, uint16_t n)
+    {
+      while (n--) transfer(*data++);
+    };
+    int8_t sckPin()
+    {
+      return -1;
+    };
+    int8_t mosiPin()
+    {
+      return -1;
+    };
+  private:
+    uint16_t _dc_tag;
+    void (*_recorder)(uint16_t tagged, void* p);
+    void* _recorder_p;
+};
+
+#endif
@@ -0,0 +1,86 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#include "GxEPD2_PageCull.h"
+
+void GxEPD2_PageCull::drawBitmap(GxEPD2_GFX_ROOT_CLASS& target, int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                                 uint16_t color, uint16_t bg, bool use_bg, bool invert, bool pgm) const
+{
+  int32_t i0 = int32_t(_x) - x, i1 = i0 + _w, j0 = int32_t(_y) - y, j1 = j0 + _h;
+  if (i0 < 0) i0 = 0;
+  if (j0 < 0) j0 = 0;
+  if (i1 > w) i1 = w;
+  if (j1 > h) j1 = h;
+  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
+  uint8_t byte = 0;
+  for (int32_t j = j0; j < j1; j++)
+  {
+    for (int32_t i = i0; i < i1; i++)
+    {
+      if ((i > i0) && (i & 7)) byte <<= 1;
+      else
+      {
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+        byte = pgm ? pgm_read_byte(&bitmap[j * byteWidth + i / 8]) : bitmap[j * byteWidth + i / 8];
+#else
+        (void) pgm;
+        byte = bitmap[j * byteWidth + i / 8];
+#endif
+        byte <<= (i & 7);
+      }
+      if (bool(byte & 0x80) != invert) target.drawPixel(x + i, y + j, color);
+      else if (use_bg) target.drawPixel(x + i, y + j, bg);
+    }
+  }
+}
+
+bool GxEPD2_PageCull::charBox(uint8_t c, const GFXfont* font, uint8_t size_x, uint8_t size_y, bool wrap, int16_t width,
+                              int16_t& x, int16_t& y, int16_t& bx, int16_t& by, int16_t& bw, int16_t& bh)
+{
+  if ((c == '\n') || (c == '\r')) return false;
+  int16_t advance;
+  if (!font) // classic font, 6x8 cell
+  {
+    if (wrap && ((x + size_x * 6) > width))
+    {
+      x = 0;
+      y += size_y * 8;
+    }
+    bx = x;
+    by = y;
+    bw = size_x * 6;
+    bh = size_y * 8;
+    advance = size_x * 6;
+  }
+  else // custom font, glyph box
+  {
+    uint8_t first = pgm_read_byte(&font->first);
+    if ((c < first) || (c > (uint8_t)pgm_read_byte(&font->last))) return false;
+#if defined(__AVR__)
+    const GFXglyph* glyph = &(((const GFXglyph*)pgm_read_word(&font->glyph))[c - first]);
+#else
+    const GFXglyph* glyph = font->glyph + (c - first);
+#endif
+    uint8_t gw = pgm_read_byte(&glyph->width), gh = pgm_read_byte(&glyph->height);
+    if ((gw == 0) || (gh == 0)) return false; // nothing to draw
+    int16_t xo = (int8_t)pgm_read_byte(&glyph->xOffset), yo = (int8_t)pgm_read_byte(&glyph->yOffset);
+    if (wrap && ((x + size_x * (xo + gw)) > width))
+    {
+      x = 0;
+      y += (int16_t)size_y * (uint8_t)pgm_read_byte(&font->yAdvance);
+    }
+    bx = x + xo * size_x;
+    by = y + yo * size_y;
+    bw = gw * size_x;
+    bh = gh * size_y;
+    advance = (uint8_t)pgm_read_byte(&glyph->xAdvance) * (int16_t)size_x;
+  }
+  x += advance;
+  return true;
+}
@@ -0,0 +1,55 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// page culling for paged drawing: primitives and characters outside the current page are skipped, instead of being clipped pixel by pixel
+//
+// used by GxEPD2_BW, GxEPD2_3C, GxEPD2_7C and GxEPD2_4G with the bounds of their current page, see getPageBounds();
+// drawChar() and drawBitmap() are not virtual in Adafruit_GFX, so the display classes hide drawBitmap() with overloads
+// and cull text in the virtual write(), these call the helpers here
+
+#ifndef _GxEPD2_PageCull_H_
+#define _GxEPD2_PageCull_H_
+
+#ifndef GxEPD2_GFX_ROOT_CLASS
+#if defined(_GFX_H_)
+#define GxEPD2_GFX_ROOT_CLASS GFX
+#else
+#include <Adafruit_GFX.h>
+#define GxEPD2_GFX_ROOT_CLASS Adafruit_GFX
+#endif
+#endif
+
+class GxEPD2_PageCull
+{
+  public:
+    // x, y, w, h : bounds of the current page in drawing coordinates
+    GxEPD2_PageCull(int16_t x, int16_t y, int16_t w, int16_t h) : _x(x), _y(y), _w(w), _h(h) {};
+    // true if x0 <= x < x1, y0 <= y < y1 intersects the page
+    bool intersects(int32_t x0, int32_t y0, int32_t x1, int32_t y1) const
+    {
+      return (x1 > _x) && (x0 < _x + _w) && (y1 > _y) && (y0 < _y + _h);
+    };
+    // true if the bounding box of the line intersects the page
+    bool intersectsLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1) const
+    {
+      return intersects(x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1, int32_t(x0 < x1 ? x1 : x0) + 1, int32_t(y0 < y1 ? y1 : y0) + 1);
+    };
+    // draws the rows and columns of a bitmap on the page to target, set bits with color, clear bits with bg if use_bg; invert swaps set and clear
+    void drawBitmap(GxEPD2_GFX_ROOT_CLASS& target, int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                    uint16_t color, uint16_t bg, bool use_bg, bool invert, bool pgm) const;
+    // box bx, by, bw, bh of character c as Adafruit_GFX::write() draws it at cursor x, y, and the cursor after it in x, y;
+    // false if write() is to handle c as is: '\n', '\r', characters without glyph or with an empty glyph;
+    // needs textsize_x of Adafruit_GFX 1.5 or later, see ENABLE_GxEPD2_TEXT_CULLING
+    static bool charBox(uint8_t c, const GFXfont* font, uint8_t size_x, uint8_t size_y, bool wrap, int16_t width,
+                        int16_t& x, int16_t& y, int16_t& bx, int16_t& by, int16_t& bw, int16_t& bh);
+  private:
+    int16_t _x, _y, _w, _h;
+};
+
+#endif
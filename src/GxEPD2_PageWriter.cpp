@@ -0,0 +1,106 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#include "GxEPD2_PageWriter.h"
+
+#if defined(ESP32)
+
+GxEPD2_TaskPageWriter::GxEPD2_TaskPageWriter(uint8_t core, uint8_t priority, uint32_t stack_size) :
+  _core(core), _priority(priority), _stack_size(stack_size), _handle(0), _done(0), _job(0), _job_p(0), _busy(false)
+{
+}
+
+void GxEPD2_TaskPageWriter::start(void (*job)(void*), void* p)
+{
+  wait();
+  if (!_handle)
+  {
+    _done = xSemaphoreCreateBinary();
+    if (!_done || (xTaskCreatePinnedToCore(_task, "GxEPD2_PageWriter", _stack_size, this, _priority, &_handle, _core) != pdPASS))
+    {
+      _handle = 0;
+      return job(p); // no task, in the foreground
+    }
+  }
+  _job = job;
+  _job_p = p;
+  _busy = true;
+  xTaskNotifyGive(_handle);
+}
+
+void GxEPD2_TaskPageWriter::wait()
+{
+  if (!_busy) return;
+  xSemaphoreTake(_done, portMAX_DELAY);
+  _busy = false;
+}
+
+void GxEPD2_TaskPageWriter::_task(void* p)
+{
+  GxEPD2_TaskPageWriter* writer = (GxEPD2_TaskPageWriter*) p;
+  while (true)
+  {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    writer->_job(writer->_job_p);
+    xSemaphoreGive(writer->_done);
+  }
+}
+
+#elif !defined(ARDUINO)
+
+GxEPD2_ThreadPageWriter::GxEPD2_ThreadPageWriter() : _job(0), _job_p(0), _busy(false), _stop(false)
+{
+  _thread = std::thread(&GxEPD2_ThreadPageWriter::_run, this);
+}
+
+GxEPD2_ThreadPageWriter::~GxEPD2_ThreadPageWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _cv.notify_all();
+  _thread.join();
+}
+
+void GxEPD2_ThreadPageWriter::start(void (*job)(void*), void* p)
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  _cv.wait(lock, [this] {return !_busy;});
+  _job = job;
+  _job_p = p;
+  _busy = true;
+  _cv.notify_all();
+}
+
+void GxEPD2_ThreadPageWriter::wait()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  _cv.wait(lock, [this] {return !_busy;});
+}
+
+void GxEPD2_ThreadPageWriter::_run()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true)
+  {
+    _cv.wait(lock, [this] {return _busy || _stop;});
+    if (_busy)
+    {
+      lock.unlock();
+      _job(_job_p);
+      lock.lock();
+      _busy = false;
+      _cv.notify_all();
+    }
+    else return;
+  }
+}
+
+#endif
@@ -0,0 +1,84 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// page writers for double buffered paged drawing, see GxEPD2_BW::setPageWriter()
+// the transfer of a page to the controller runs in the background, while the next page is drawn to the second page buffer
+//
+// GxEPD2_PageWriter       : runs the transfer in the foreground, no overlap
+// GxEPD2_TaskPageWriter   : FreeRTOS task on ESP32, e.g. on the core the sketch doesn't use
+// GxEPD2_ThreadPageWriter : std::thread, for host builds (ARDUINO not defined), e.g. to measure the overlap
+//
+// the display must not be used by other tasks during paged drawing, nor other devices on the same SPI bus
+
+#ifndef _GxEPD2_PageWriter_H_
+#define _GxEPD2_PageWriter_H_
+
+#include <Arduino.h>
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#elif !defined(ARDUINO)
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+class GxEPD2_PageWriter
+{
+  public:
+    virtual ~GxEPD2_PageWriter() {};
+    // runs job(p), in the background if supported, after the previous job is done
+    virtual void start(void (*job)(void*), void* p)
+    {
+      job(p);
+    };
+    // returns when the last job is done
+    virtual void wait() {};
+};
+
+#if defined(ESP32)
+class GxEPD2_TaskPageWriter : public GxEPD2_PageWriter
+{
+  public:
+    // core : core of the task, e.g. 0 if the sketch runs on core 1 (default of Arduino ESP32); the task is created on first use
+    GxEPD2_TaskPageWriter(uint8_t core = 0, uint8_t priority = 1, uint32_t stack_size = 4096);
+    void start(void (*job)(void*), void* p);
+    void wait();
+  private:
+    static void _task(void* p);
+    uint8_t _core, _priority;
+    uint32_t _stack_size;
+    TaskHandle_t _handle;
+    SemaphoreHandle_t _done;
+    void (*_job)(void*);
+    void* _job_p;
+    bool _busy;
+};
+#elif !defined(ARDUINO)
+class GxEPD2_ThreadPageWriter : public GxEPD2_PageWriter
+{
+  public:
+    GxEPD2_ThreadPageWriter();
+    ~GxEPD2_ThreadPageWriter();
+    void start(void (*job)(void*), void* p);
+    void wait();
+  private:
+    void _run();
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    void (*_job)(void*);
+    void* _job_p;
+    bool _busy, _stop;
+};
+#endif
+
+#endif
@@ -0,0 +1,62 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#include "GxEPD2_RLE.h"
+
+uint32_t GxEPD2_rleEncode(const uint8_t* src, uint32_t n, uint8_t* dst, uint32_t size)
+{
+  uint32_t i = 0, o = 0;
+  while (i < n)
+  {
+    uint32_t run = 1;
+    while ((i + run < n) && (run < 129) && (src[i + run] == src[i])) run++;
+    if (run >= 2)
+    {
+      if (o + 2 > size) return 0;
+      dst[o++] = 0x80 + run - 2;
+      dst[o++] = src[i];
+      i += run;
+    }
+    else
+    {
+      // literal bytes up to the start of the next run
+      uint32_t count = 1;
+      while ((i + count < n) && (count < 128) && !((i + count + 1 < n) && (src[i + count] == src[i + count + 1]))) count++;
+      if (o + 1 + count > size) return 0;
+      dst[o++] = count - 1;
+      memcpy(dst + o, src + i, count);
+      o += count;
+      i += count;
+    }
+  }
+  return o;
+}
+
+const uint8_t* GxEPD2_rleDecode(const uint8_t* src, uint8_t* dst, uint32_t n)
+{
+  uint8_t* end = dst + n;
+  while (dst < end)
+  {
+    uint8_t c = *src++;
+    if (c < 0x80)
+    {
+      uint16_t count = c + 1;
+      memcpy(dst, src, count);
+      dst += count;
+      src += count;
+    }
+    else
+    {
+      uint16_t count = c - 0x80 + 2;
+      memset(dst, *src++, count);
+      dst += count;
+    }
+  }
+  return src;
+}
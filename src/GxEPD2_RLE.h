@@ -0,0 +1,23 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// run length encoding of buffer content, e.g. of page buffers, PackBits like:
+// control byte c < 0x80: c + 1 literal bytes follow; c >= 0x80: the next byte is repeated c - 0x80 + 2 times
+
+#ifndef _GxEPD2_RLE_H_
+#define _GxEPD2_RLE_H_
+
+#include <Arduino.h>
+
+// encodes n bytes into dst of size bytes, returns the encoded size, 0 if it doesn't fit
+uint32_t GxEPD2_rleEncode(const uint8_t* src, uint32_t n, uint8_t* dst, uint32_t size);
+// decodes n bytes into dst, returns the end of the encoded data, e.g. the start of the next encoded block
+const uint8_t* GxEPD2_rleDecode(const uint8_t* src, uint8_t* dst, uint32_t n);
+
+#endif
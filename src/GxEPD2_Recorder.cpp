@@ -0,0 +1,137 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#include "GxEPD2_Recorder.h"
+
+static void GxEPD2_put32(uint8_t* p, uint32_t value)
+{
+  p[0] = value & 0xFF;
+  p[1] = (value >> 8) & 0xFF;
+  p[2] = (value >> 16) & 0xFF;
+  p[3] = value >> 24;
+}
+
+void GxEPD2_Recorder::command(uint8_t c)
+{
+  uint8_t record[6];
+  record[0] = Command;
+  GxEPD2_put32(record + 1, micros());
+  record[5] = c;
+  if (_begin(sizeof(record))) _write(record, sizeof(record));
+  else _dropped++;
+}
+
+void GxEPD2_Recorder::data(uint8_t d)
+{
+  uint8_t record[2] = {Data1, d};
+  if (_begin(sizeof(record))) _write(record, sizeof(record));
+  else _dropped++;
+}
+
+void GxEPD2_Recorder::data(const uint8_t* d, uint16_t n)
+{
+  if (n == 1) return data(*d);
+  uint8_t header[3] = {Data, uint8_t(n & 0xFF), uint8_t(n >> 8)};
+  if (_begin(sizeof(header) + uint32_t(n)))
+  {
+    _write(header, sizeof(header));
+    _write(d, n);
+  }
+  else _dropped++;
+}
+
+void GxEPD2_Recorder::busy(unsigned long start, unsigned long duration)
+{
+  uint8_t record[9];
+  record[0] = Busy;
+  GxEPD2_put32(record + 1, start);
+  GxEPD2_put32(record + 5, duration);
+  if (_begin(sizeof(record))) _write(record, sizeof(record));
+  else _dropped++;
+}
+
+GxEPD2_RingRecorder::GxEPD2_RingRecorder(uint8_t* buffer, uint32_t size) :
+  _buffer(buffer), _size(size), _head(0), _tail(0), _used(0)
+{
+}
+
+uint32_t GxEPD2_RingRecorder::available()
+{
+  return _used;
+}
+
+uint32_t GxEPD2_RingRecorder::read(uint8_t* d, uint32_t n)
+{
+  uint32_t count = 0;
+  while (_used > 0)
+  {
+    uint32_t record_size = _recordSize();
+    if (count + record_size > n) break;
+    for (uint32_t i = 0; i < record_size; i++)
+    {
+      d[count++] = _buffer[_tail];
+      _tail = (_tail + 1) % _size;
+    }
+    _used -= record_size;
+  }
+  return count;
+}
+
+void GxEPD2_RingRecorder::clear()
+{
+  _head = 0;
+  _tail = 0;
+  _used = 0;
+  _dropped = 0;
+}
+
+bool GxEPD2_RingRecorder::_begin(uint32_t n)
+{
+  if (n > _size) return false;
+  while (_size - _used < n)
+  {
+    // drop oldest record
+    uint32_t record_size = _recordSize();
+    _tail = (_tail + record_size) % _size;
+    _used -= record_size;
+    _dropped++;
+  }
+  return true;
+}
+
+void GxEPD2_RingRecorder::_write(const uint8_t* d, uint16_t n)
+{
+  for (uint16_t i = 0; i < n; i++)
+  {
+    _buffer[_head] = d[i];
+    _head = (_head + 1) % _size;
+  }
+  _used += n;
+}
+
+uint8_t GxEPD2_RingRecorder::_peek(uint32_t offset)
+{
+  return _buffer[(_tail + offset) % _size];
+}
+
+uint32_t GxEPD2_RingRecorder::_recordSize()
+{
+  switch (_peek(0))
+  {
+    case Command:
+      return 6;
+    case Data:
+      return 3 + (_peek(1) | (uint32_t(_peek(2)) << 8));
+    case Data1:
+      return 2;
+    case Busy:
+      return 9;
+  }
+  return _used; // corrupt, drop all
+}
@@ -0,0 +1,80 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// command stream recorder for GxEPD2_EPD, enable with build flag ENABLE_GxEPD2_RECORDER=1, use display.epd2.setRecorder(&recorder);
+// records command, data and busy events in a compact binary format, to a ring buffer or to a sink, e.g. a file
+// replay and report on a host with extras/replay
+//
+// record format, little endian:
+// Command : 0x01, time (4 bytes, micros()), command
+// Data    : 0x02, count (2 bytes), data[count]
+// Data1   : 0x03, data
+// Busy    : 0x04, time (4 bytes, micros() at start), duration (4 bytes, us)
+
+#ifndef _GxEPD2_Recorder_H_
+#define _GxEPD2_Recorder_H_
+
+#include <Arduino.h>
+
+class GxEPD2_Recorder
+{
+  public:
+    enum Event {Command = 0x01, Data = 0x02, Data1 = 0x03, Busy = 0x04};
+    GxEPD2_Recorder() : _dropped(0) {};
+    void command(uint8_t c);
+    void data(uint8_t d);
+    void data(const uint8_t* d, uint16_t n);
+    void busy(unsigned long start, unsigned long duration);
+    uint32_t dropped() // records dropped, e.g. on overflow
+    {
+      return _dropped;
+    };
+  protected:
+    virtual bool _begin(uint32_t n) // make room for a record of n bytes, false to drop it
+    {
+      return true;
+    };
+    virtual void _write(const uint8_t* d, uint16_t n) = 0;
+    uint32_t _dropped;
+};
+
+// ring buffer in caller supplied memory, drops oldest records when full
+class GxEPD2_RingRecorder : public GxEPD2_Recorder
+{
+  public:
+    GxEPD2_RingRecorder(uint8_t* buffer, uint32_t size);
+    uint32_t available(); // bytes recorded
+    uint32_t read(uint8_t* d, uint32_t n); // reads and removes oldest records that fit into n bytes, returns bytes read
+    void clear();
+  protected:
+    bool _begin(uint32_t n);
+    void _write(const uint8_t* d, uint16_t n);
+  private:
+    uint8_t _peek(uint32_t offset);
+    uint32_t _recordSize();
+    uint8_t* _buffer;
+    uint32_t _size, _head, _tail, _used;
+};
+
+// sink callback, e.g. to write to a file or to Serial
+class GxEPD2_SinkRecorder : public GxEPD2_Recorder
+{
+  public:
+    GxEPD2_SinkRecorder(void (*sink)(const uint8_t* data, uint16_t n, void* p), void* p = 0) : _sink(sink), _sink_p(p) {};
+  protected:
+    void _write(const uint8_t* d, uint16_t n)
+    {
+      _sink(d, n, _sink_p);
+    };
+  private:
+    void (*_sink)(const uint8_t* data, uint16_t n, void* p);
+    void* _sink_p;
+};
+
+#endif
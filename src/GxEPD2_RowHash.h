@@ -0,0 +1,105 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// hashes of bands of rows of the last frame sent, for GxEPD2_BW and GxEPD2_3C with ENABLE_GxEPD2_ROW_HASH, see GxEPD2_EPD.h
+// FNV-1a over GxEPD2_ROW_HASH_BAND rows of the buffer planes; a band is changed if its hash differs from the last frame,
+// all bands are changed after invalidate(), which the displays call for every write to the controller other than a hashed frame
+
+#ifndef _GxEPD2_RowHash_H_
+#define _GxEPD2_RowHash_H_
+
+#include "GxEPD2_EPD.h"
+
+template<uint16_t width, uint16_t height>
+class GxEPD2_RowHash
+{
+  public:
+    GxEPD2_RowHash() : _acc(0), _valid(false), _changed(false) {};
+    void invalidate()
+    {
+      _valid = false;
+    };
+    // hashes rows ys <= y < ye of one or two planes of rows of width / 8 bytes, from row ys, e.g. a page buffer;
+    // rows from 0 start a new frame; returns true if a band of these rows changed, or if the last band continues on the next rows
+    bool hashRows(uint16_t ys, uint16_t ye, const uint8_t* plane1, const uint8_t* plane2 = 0)
+    {
+      if (0 == ys) _changed = false;
+      bool changed = false;
+      for (uint16_t y = ys; y < ye; y++)
+      {
+        if (0 == y % GxEPD2_ROW_HASH_BAND) _acc = 2166136261ul;
+        for (uint16_t i = 0; i < width / 8; i++) _acc = (_acc ^ *plane1++) * 16777619ul;
+        if (plane2) for (uint16_t i = 0; i < width / 8; i++) _acc = (_acc ^ *plane2++) * 16777619ul;
+        if ((0 == (y + 1) % GxEPD2_ROW_HASH_BAND) || (y + 1 == height))
+        {
+          uint16_t band = y / GxEPD2_ROW_HASH_BAND;
+          bool band_changed = !_valid || (_hash[band] != _acc);
+          _hash[band] = _acc;
+          if (band_changed) _band_changed[band / 8] |= 1 << (band % 8);
+          else _band_changed[band / 8] &= ~(1 << (band % 8));
+          changed |= band_changed;
+        }
+      }
+      if (ye == height) _valid = true;
+      _changed |= changed;
+      return changed || ((ye < height) && (0 != ye % GxEPD2_ROW_HASH_BAND));
+    };
+    // true if a band changed in the frame hashed last
+    bool changed()
+    {
+      return _changed;
+    };
+    // true if a band of rows ys <= y < ye changed in the frame hashed last
+    bool changed(uint16_t ys, uint16_t ye)
+    {
+      if (!_valid) return true;
+      for (uint16_t band = ys / GxEPD2_ROW_HASH_BAND; band * GxEPD2_ROW_HASH_BAND < ye; band++)
+      {
+        if (_band_changed[band / 8] & (1 << (band % 8))) return true;
+      }
+      return false;
+    };
+    // partial update of the changed bands of a full screen buffer, refresh of their bounding rows;
+    // display._writeChangedRows(ys, ye, again) writes buffer rows ys <= y < ye, reverse for buffers of bottom up rows
+    template<typename GxEPD2_Display> void displayChanged(GxEPD2_Display& display, bool reverse)
+    {
+      uint16_t ys, ye, refresh_ys = height, refresh_ye = 0;
+      for (uint16_t y = 0; _changedRows(y, ys, ye); y = ye)
+      {
+        display._writeChangedRows(ys, ye, false);
+        uint16_t dest_ys = reverse ? height - ye : ys;
+        if (dest_ys < refresh_ys) refresh_ys = dest_ys;
+        if (dest_ys + ye - ys > refresh_ye) refresh_ye = dest_ys + ye - ys;
+      }
+      display.epd2.refresh(0, refresh_ys, width, refresh_ye - refresh_ys);
+      if (display.epd2.hasFastPartialUpdate)
+      {
+        for (uint16_t y = 0; _changedRows(y, ys, ye); y = ye) display._writeChangedRows(ys, ye, true);
+      }
+    };
+  private:
+    // finds the next run of changed bands from row y on, as rows ys <= y < ye
+    bool _changedRows(uint16_t y, uint16_t& ys, uint16_t& ye)
+    {
+      uint16_t band = y / GxEPD2_ROW_HASH_BAND;
+      while ((band < _bands) && !(_band_changed[band / 8] & (1 << (band % 8)))) band++;
+      if (band == _bands) return false;
+      ys = band * GxEPD2_ROW_HASH_BAND;
+      while ((band < _bands) && (_band_changed[band / 8] & (1 << (band % 8)))) band++;
+      ye = band * GxEPD2_ROW_HASH_BAND < height ? band * GxEPD2_ROW_HASH_BAND : height;
+      return true;
+    };
+    static const uint16_t _bands = (height + GxEPD2_ROW_HASH_BAND - 1) / GxEPD2_ROW_HASH_BAND;
+    uint32_t _hash[_bands];
+    uint8_t _band_changed[(_bands + 7) / 8];
+    uint32_t _acc;
+    bool _valid, _changed;
+};
+
+#endif
@@ -0,0 +1,382 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// bus transport classes for GxEPD2_EPD, the transport parameter of the display templates, default is GxEPD2_HwSpi, e.g.
+// GxEPD2_BW<GxEPD2_290_T94, GxEPD2_290_T94::HEIGHT, GxEPD2_SwSpi> display(GxEPD2_290_T94(/*CS=*/ 5, /*DC=*/ 17, /*RST=*/ 16, /*BUSY=*/ 4));
+// displays with different transports can be used in the same build, e.g. a panel and a mock
+//
+// GxEPD2_HwSpi   : global SPI object
+// GxEPD2_SpiClass: any SPIClass instance, e.g. display.transport().setSPI(hspi);
+// GxEPD2_SwSpi   : bit-banged SPI on any pins, e.g. display.transport().setPins(sck, mosi); before display.init()
+// GxEPD2_MockSpi : records traffic, no bus access, for benchmarks and tests on a host, see GxEPD2_MockSpi.h
+//
+// the transport classes have no virtual methods; GxEPD2_EPD calls its transport through GxEPD2_Bus, one call per command byte
+// or per block of data, GxEPD2_TransportBus inlines the transport in it
+
+#ifndef _GxEPD2_Transport_H_
+#define _GxEPD2_Transport_H_
+
+#include <Arduino.h>
+#include <SPI.h>
+#include "GxEPD2_MockSpi.h"
+
+class GxEPD2_HwSpi
+{
+  public:
+    void begin()
+    {
+      SPI.begin();
+    };
+    void end()
+    {
+      SPI.end();
+    };
+    void beginTransaction(const SPISettings& settings)
+    {
+      SPI.beginTransaction(settings);
+    };
+    void endTransaction()
+    {
+      SPI.endTransaction();
+    };
+    uint8_t transfer(uint8_t data)
+    {
+      return SPI.transfer(data);
+    };
+    // block write, may overwrite data with received data
+    void writeBytes(uint8_t* data, uint16_t n)
+    {
+#if defined(ESP8266) || defined(ESP32)
+      SPI.writeBytes(data, n);
+#else
+      SPI.transfer(data, n);
+#endif
+    };
+    // state of the DC line, driven by GxEPD2_EPD, seen only by transports that record traffic
+    void setDC(bool data)
+    {
+    };
+    int8_t sckPin()
+    {
+      return SCK;
+    };
+    int8_t mosiPin()
+    {
+      return MOSI;
+    };
+};
+
+class GxEPD2_SpiClass
+{
+  public:
+    GxEPD2_SpiClass() : _spi(&SPI), _sck(SCK), _mosi(MOSI) {};
+    void setSPI(SPIClass& spi, int8_t sck = SCK, int8_t mosi = MOSI)
+    {
+      _spi = &spi;
+      _sck = sck;
+      _mosi = mosi;
+    };
+    void begin()
+    {
+      _spi->begin();
+    };
+    void end()
+    {
+      _spi->end();
+    };
+    void beginTransaction(const SPISettings& settings)
+    {
+      _spi->beginTransaction(settings);
+    };
+    void endTransaction()
+    {
+      _spi->endTransaction();
+    };
+    uint8_t transfer(uint8_t data)
+    {
+      return _spi->transfer(data);
+    };
+    // block write, may overwrite data with received data
+    void writeBytes(uint8_t* data, uint16_t n)
+    {
+#if defined(ESP8266) || defined(ESP32)
+      _spi->writeBytes(data, n);
+#else
+      _spi->transfer(data, n);
+#endif
+    };
+    // state of the DC line, driven by GxEPD2_EPD, seen only by transports that record traffic
+    void setDC(bool data)
+    {
+    };
+    int8_t sckPin()
+    {
+      return _sck;
+    };
+    int8_t mosiPin()
+    {
+      return _mosi;
+    };
+  private:
+    SPIClass* _spi;
+    int8_t _sck, _mosi;
+};
+
+// fast path for GxEPD2_SwSpi: direct port register access with cached registers and mask, unrolled bit loop
+// the clock high time is one port register write; define GxEPD2_SWSPI_FAST 0 to use digitalWrite() instead
+// ESP32 and ESP8266 write the set and clear registers, other pins of the port are not touched, e.g. by an interrupt handler;
+// AVR reads, modifies and writes the port register, as digitalWrite() does, but without disabling interrupts;
+// other platforms with portOutputRegister() do the same if built with GxEPD2_SWSPI_FAST 1
+#ifndef GxEPD2_SWSPI_FAST
+#if defined(ESP32) || defined(ESP8266)
+#define GxEPD2_SWSPI_FAST 1
+#elif defined(__AVR) && defined(portOutputRegister) && defined(digitalPinToPort) && defined(digitalPinToBitMask)
+#define GxEPD2_SWSPI_FAST 1
+#else
+#define GxEPD2_SWSPI_FAST 0
+#endif
+#endif
+
+#if GxEPD2_SWSPI_FAST
+#if defined(ESP32) || defined(ESP8266)
+#if defined(ESP32)
+#include <soc/gpio_struct.h>
+#include <soc/gpio_reg.h>
+#endif
+typedef volatile uint32_t GxEPD2_SwSpiPort;
+typedef uint32_t GxEPD2_SwSpiMask;
+#define GxEPD2_SWSPI_SET(reg, mask) *(reg) = (mask)
+#define GxEPD2_SWSPI_CLR(reg, mask) *(reg) = (mask)
+#else
+#if defined(__AVR)
+typedef volatile uint8_t GxEPD2_SwSpiPort;
+typedef uint8_t GxEPD2_SwSpiMask;
+#else
+typedef volatile uint32_t GxEPD2_SwSpiPort;
+typedef uint32_t GxEPD2_SwSpiMask;
+#endif
+#define GxEPD2_SWSPI_SET(reg, mask) *(reg) |= (mask)
+#define GxEPD2_SWSPI_CLR(reg, mask) *(reg) &= ~(mask)
+#endif
+#define GxEPD2_SWSPI_BIT(bit) \
+  if (data & bit) GxEPD2_SWSPI_SET(mosi_set, mosi_mask); else GxEPD2_SWSPI_CLR(mosi_clr, mosi_mask); \
+  GxEPD2_SWSPI_SET(sck_set, sck_mask); \
+  GxEPD2_SWSPI_CLR(sck_clr, sck_mask);
+#endif
+
+class GxEPD2_SwSpi
+{
+  public:
+    GxEPD2_SwSpi() : _sck(-1), _mosi(-1), _miso(-1), _fast(false) {};
+    // miso is optional, only needed by controllers that are read through a separate data out line, e.g. IT8951
+    void setPins(int8_t sck, int8_t mosi, int8_t miso = -1)
+    {
+      _sck = sck;
+      _mosi = mosi;
+      _miso = miso;
+    };
+    void begin()
+    {
+      if ((_sck < 0) || (_mosi < 0)) return;
+      digitalWrite(_sck, LOW);
+      digitalWrite(_mosi, LOW);
+      pinMode(_sck, OUTPUT);
+      pinMode(_mosi, OUTPUT);
+      if (_miso >= 0) pinMode(_miso, INPUT);
+#if GxEPD2_SWSPI_FAST
+      _fast = _registers(_sck, _sck_set, _sck_clr, _sck_mask) && _registers(_mosi, _mosi_set, _mosi_clr, _mosi_mask);
+#endif
+    };
+    void end()
+    {
+    };
+    void beginTransaction(const SPISettings& settings)
+    {
+    };
+    void endTransaction()
+    {
+    };
+    uint8_t transfer(uint8_t data)
+    {
+      if ((_sck < 0) || (_mosi < 0)) return 0;
+#if GxEPD2_SWSPI_FAST
+      if (_fast && (_miso < 0))
+      {
+        _writeFast(&data, 1); // no yield() per byte
+        return 0;
+      }
+#endif
+      uint8_t value = 0;
+      for (uint8_t i = 0; i < 8; i++)
+      {
+        digitalWrite(_mosi, (data & 0x80) ? HIGH : LOW);
+        data <<= 1;
+        digitalWrite(_sck, HIGH);
+        value <<= 1;
+        if ((_miso >= 0) && digitalRead(_miso)) value |= 0x01;
+        digitalWrite(_sck, LOW);
+      }
+      return value;
+    };
+    // block write, e.g. a whole row, port and masks are kept in registers
+    void writeBytes(uint8_t* buffer, uint16_t n)
+    {
+#if defined (ESP8266)
+      yield();
+#endif
+#if GxEPD2_SWSPI_FAST
+      if ((_sck < 0) || (_mosi < 0)) return;
+      if (_fast)
+      {
+        _writeFast(buffer, n);
+        return;
+      }
+#endif
+      while (n--) transfer(*buffer++);
+    };
+    // state of the DC line, driven by GxEPD2_EPD, seen only by transports that record traffic
+    void setDC(bool data)
+    {
+    };
+    int8_t sckPin()
+    {
+      return _sck;
+    };
+    int8_t mosiPin()
+    {
+      return _mosi;
+    };
+  private:
+#if GxEPD2_SWSPI_FAST
+    // set and clear register and mask of pin, set and clear register are the port register on AVR; false if pin has none
+    static bool _registers(int8_t pin, GxEPD2_SwSpiPort*& set, GxEPD2_SwSpiPort*& clr, GxEPD2_SwSpiMask& mask)
+    {
+#if defined(ESP32)
+      if (pin < 32)
+      {
+        set = (GxEPD2_SwSpiPort*) &GPIO.out_w1ts;
+        clr = (GxEPD2_SwSpiPort*) &GPIO.out_w1tc;
+        mask = 1ul << pin;
+        return true;
+      }
+#if defined(GPIO_OUT1_W1TS_REG)
+      set = (GxEPD2_SwSpiPort*) &GPIO.out1_w1ts;
+      clr = (GxEPD2_SwSpiPort*) &GPIO.out1_w1tc;
+      mask = 1ul << (pin - 32);
+      return true;
+#else
+      return false;
+#endif
+#elif defined(ESP8266)
+      if (pin >= 16) return false; // GPIO16 has no set and clear registers
+      set = (GxEPD2_SwSpiPort*) &GPOS;
+      clr = (GxEPD2_SwSpiPort*) &GPOC;
+      mask = 1ul << pin;
+      return true;
+#else
+      set = clr = (GxEPD2_SwSpiPort*) portOutputRegister(digitalPinToPort(pin));
+      mask = digitalPinToBitMask(pin);
+      return true;
+#endif
+    };
+    // bit loop of writeBytes() and of transfer() without miso, no yield()
+    void _writeFast(const uint8_t* buffer, uint16_t n)
+    {
+      GxEPD2_SwSpiPort* sck_set = _sck_set;
+      GxEPD2_SwSpiPort* sck_clr = _sck_clr;
+      GxEPD2_SwSpiPort* mosi_set = _mosi_set;
+      GxEPD2_SwSpiPort* mosi_clr = _mosi_clr;
+      const GxEPD2_SwSpiMask sck_mask = _sck_mask, mosi_mask = _mosi_mask;
+      while (n--)
+      {
+        uint8_t data = *buffer++;
+        GxEPD2_SWSPI_BIT(0x80);
+        GxEPD2_SWSPI_BIT(0x40);
+        GxEPD2_SWSPI_BIT(0x20);
+        GxEPD2_SWSPI_BIT(0x10);
+        GxEPD2_SWSPI_BIT(0x08);
+        GxEPD2_SWSPI_BIT(0x04);
+        GxEPD2_SWSPI_BIT(0x02);
+        GxEPD2_SWSPI_BIT(0x01);
+      }
+    };
+#endif
+    int8_t _sck, _mosi, _miso;
+    bool _fast; // both pins have registers for the fast path
+#if GxEPD2_SWSPI_FAST
+    GxEPD2_SwSpiPort* _sck_set;
+    GxEPD2_SwSpiPort* _sck_clr;
+    GxEPD2_SwSpiPort* _mosi_set;
+    GxEPD2_SwSpiPort* _mosi_clr;
+    GxEPD2_SwSpiMask _sck_mask, _mosi_mask;
+#endif
+};
+
+// bus interface of GxEPD2_EPD, see GxEPD2_EPD::setBus()
+class GxEPD2_Bus
+{
+  public:
+    virtual void begin() = 0;
+    virtual void end() = 0;
+    virtual void beginTransaction(const SPISettings& settings) = 0;
+    virtual void endTransaction() = 0;
+    virtual uint8_t transfer(uint8_t data) = 0;
+    // block write, may overwrite data with received data
+    virtual void writeBytes(uint8_t* data, uint16_t n) = 0;
+    // state of the DC line, driven by GxEPD2_EPD
+    virtual void setDC(bool data) = 0;
+    virtual int8_t sckPin() = 0;
+    virtual int8_t mosiPin() = 0;
+};
+
+// GxEPD2_Bus of a transport class, owned by the display templates
+template<typename GxEPD2_Transport>
+class GxEPD2_TransportBus : public GxEPD2_Bus
+{
+  public:
+    GxEPD2_Transport transport;
+    void begin()
+    {
+      transport.begin();
+    };
+    void end()
+    {
+      transport.end();
+    };
+    void beginTransaction(const SPISettings& settings)
+    {
+      transport.beginTransaction(settings);
+    };
+    void endTransaction()
+    {
+      transport.endTransaction();
+    };
+    uint8_t transfer(uint8_t data)
+    {
+      return transport.transfer(data);
+    };
+    void writeBytes(uint8_t* data, uint16_t n)
+    {
+      transport.writeBytes(data, n);
+    };
+    void setDC(bool data)
+    {
+      transport.setDC(data);
+    };
+    int8_t sckPin()
+    {
+      return transport.sckPin();
+    };
+    int8_t mosiPin()
+    {
+      return transport.mosiPin();
+    };
+};
+
+#endif
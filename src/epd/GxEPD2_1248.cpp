@@ -274,6 +274,15 @@ void GxEPD2_1248::hibernate()
   }
 }
 
+void GxEPD2_1248::setSpiFrequency(uint32_t frequency)
+{
+  GxEPD2_EPD::setSpiFrequency(frequency);
+  M1.setSpiFrequency(frequency);
+  S1.setSpiFrequency(frequency);
+  M2.setSpiFrequency(frequency);
+  S2.setSpiFrequency(frequency);
+}
+
 void GxEPD2_1248::_reset(void)
 {
   digitalWrite(_rst1, LOW);
@@ -502,12 +511,14 @@ void GxEPD2_1248::_Init_Part()
 
 void GxEPD2_1248::_Update_Full()
 {
+  _statsRefresh(false);
   _writeCommandAll(0x12); //display refresh
   _waitWhileAnyBusy("_Update_Full", full_refresh_time);
 }
 
 void GxEPD2_1248::_Update_Part()
 {
+  _statsRefresh(true);
   _writeCommandAll(0x12); //display refresh
   _waitWhileAnyBusy("_Update_Part", partial_refresh_time);
 }
@@ -708,13 +719,20 @@ GxEPD2_1248::ScreenPart::ScreenPart(uint16_t width, uint16_t height, bool rev_sc
 {
 }
 
+void GxEPD2_1248::ScreenPart::setSpiFrequency(uint32_t frequency)
+{
+  _spi_settings = SPISettings(frequency, MSBFIRST, SPI_MODE0);
+}
+
 void GxEPD2_1248::ScreenPart::writeScreenBuffer(uint8_t command, uint8_t value)
 {
   writeCommand(command); // set current or previous
+  _startTransfer();
   for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
   {
-    writeData(value);
+    _transfer(value);
   }
+  _endTransfer();
 }
 
 void GxEPD2_1248::ScreenPart::writeImagePart(uint8_t command, const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
@@ -801,15 +819,17 @@ void GxEPD2_1248::ScreenPart::_setPartialRamArea(uint16_t x, uint16_t y, uint16_
   uint16_t ye = y + h - 1;
   x &= 0xFFF8; // byte boundary
   writeCommand(0x90); // partial window
-  writeData(x / 256);
-  writeData(x % 256);
-  writeData(xe / 256);
-  writeData(xe % 256);
-  writeData(y / 256);
-  writeData(y % 256);
-  writeData(ye / 256);
-  writeData(ye % 256);
-  writeData(0x01);
+  _startTransfer();
+  _transfer(x / 256);
+  _transfer(x % 256);
+  _transfer(xe / 256);
+  _transfer(xe % 256);
+  _transfer(y / 256);
+  _transfer(y % 256);
+  _transfer(ye / 256);
+  _transfer(ye % 256);
+  _transfer(0x01);
+  _endTransfer();
 }
 
 void GxEPD2_1248::ScreenPart::_startTransfer()
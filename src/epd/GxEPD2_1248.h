@@ -77,6 +77,7 @@ class GxEPD2_1248 : public GxEPD2_EPD
     void refresh(int16_t x, int16_t y, int16_t w, int16_t h); // screen refresh from controller memory, partial screen
     void powerOff(); // turns off generation of panel driving voltages, avoids screen fading over time
     void hibernate(); // turns powerOff() and sets controller to deep sleep for minimum power use, ONLY if wakeable by RST (rst >= 0)
+    void setSpiFrequency(uint32_t frequency); // SPI clock for writes, for all screen parts
   private:
     void _reset();
     void _initSPI();
@@ -119,6 +120,7 @@ class GxEPD2_1248 : public GxEPD2_EPD
                             int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
         void writeCommand(uint8_t c);
         void writeData(uint8_t d);
+        void setSpiFrequency(uint32_t frequency);
       private:
         void _setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
         void _startTransfer();
@@ -129,7 +131,7 @@ class GxEPD2_1248 : public GxEPD2_EPD
       private:
         bool _rev_scan;
         int8_t _cs, _dc;
-        const SPISettings _spi_settings;
+        SPISettings _spi_settings;
     };
     ScreenPart M1, S1, M2, S2;
 };
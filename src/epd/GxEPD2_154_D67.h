@@ -14,9 +14,9 @@
 #ifndef _GxEPD2_154_D67_H_
 #define _GxEPD2_154_D67_H_
 
-#include "../GxEPD2_EPD.h"
+#include "GxEPD2_SSD168x.h"
 
-class GxEPD2_154_D67 : public GxEPD2_EPD
+class GxEPD2_154_D67 : public GxEPD2_SSD168x
 {
   public:
     // attributes
@@ -32,51 +32,9 @@ class GxEPD2_154_D67 : public GxEPD2_EPD
     static const uint16_t partial_refresh_time = 500; // ms, e.g. 457282us
     // constructor
     GxEPD2_154_D67(int8_t cs, int8_t dc, int8_t rst, int8_t busy);
-    // methods (virtual)
-    //  Support for Bitmaps (Sprites) to Controller Buffer and to Screen
-    void clearScreen(uint8_t value = 0xFF); // init controller memory and screen (default white)
-    void writeScreenBuffer(uint8_t value = 0xFF); // init controller memory (default white)
-    void writeScreenBufferAgain(uint8_t value = 0xFF); // init previous buffer controller memory (default white)
-    // write to controller memory, without screen refresh; x and w should be multiple of 8
-    void writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
-    void writeImageForFullRefresh(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
-    void writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
-                        int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
-    void writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
-    void writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
-                        int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
-    // for differential update: set current and previous buffers equal (for fast partial update to work correctly)
-    void writeImageAgain(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
-    void writeImagePartAgain(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
-                             int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
-    // write sprite of native data to controller memory, without screen refresh; x and w should be multiple of 8
-    void writeNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
-    // write to controller memory, with screen refresh; x and w should be multiple of 8
-    void drawImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
-    void drawImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
-                       int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
-    void drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
-    void drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
-                       int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
-    // write sprite of native data to controller memory, with screen refresh; x and w should be multiple of 8
-    void drawNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
-    void refresh(bool partial_update_mode = false); // screen refresh from controller memory to full screen
-    void refresh(int16_t x, int16_t y, int16_t w, int16_t h); // screen refresh from controller memory, partial screen
-    void powerOff(); // turns off generation of panel driving voltages, avoids screen fading over time
-    void hibernate(); // turns powerOff() and sets controller to deep sleep for minimum power use, ONLY if wakeable by RST (rst >= 0)
   private:
-    void _writeScreenBuffer(uint8_t command, uint8_t value);
-    void _writeImage(uint8_t command, const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
-    void _writeImagePart(uint8_t command, const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
-                         int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
-    void _setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
-    void _PowerOn();
-    void _PowerOff();
-    void _InitDisplay();
-    void _Init_Full();
-    void _Init_Part();
-    void _Update_Full();
-    void _Update_Part();
+    static const unsigned char init_display[];
+    static const Descriptor descriptor;
 };
 
 #endif
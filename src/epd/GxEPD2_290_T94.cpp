@@ -13,124 +13,44 @@
 
 #include "GxEPD2_290_T94.h"
 
-GxEPD2_290_T94::GxEPD2_290_T94(int8_t cs, int8_t dc, int8_t rst, int8_t busy) :
-  GxEPD2_EPD(cs, dc, rst, busy, HIGH, 10000000, WIDTH, HEIGHT, panel, hasColor, hasPartialUpdate, hasFastPartialUpdate)
-{
-}
-
-void GxEPD2_290_T94::clearScreen(uint8_t value)
-{
-  writeScreenBuffer(value);
-  refresh(true);
-  writeScreenBufferAgain(value);
-}
-
-void GxEPD2_290_T94::writeScreenBuffer(uint8_t value)
-{
-  if (!_using_partial_mode) _Init_Part();
-  if (_initial_write) _writeScreenBuffer(0x26, value); // set previous
-  _writeScreenBuffer(0x24, value); // set current
-  _initial_write = false; // initial full screen buffer clean done
-}
-
-void GxEPD2_290_T94::writeScreenBufferAgain(uint8_t value)
-{
-  if (!_using_partial_mode) _Init_Part();
-  _writeScreenBuffer(0x24, value); // set current
-}
-
-void GxEPD2_290_T94::_writeScreenBuffer(uint8_t command, uint8_t value)
-{
-  _writeCommand(command);
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _writeData(value);
-  }
-}
-
-void GxEPD2_290_T94::writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  _writeImage(0x24, bitmap, x, y, w, h, invert, mirror_y, pgm);
-}
-
-void GxEPD2_290_T94::writeImageForFullRefresh(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+const unsigned char GxEPD2_290_T94::init_display[] PROGMEM =
 {
-  _writeImage(0x26, bitmap, x, y, w, h, invert, mirror_y, pgm);
-  _writeImage(0x24, bitmap, x, y, w, h, invert, mirror_y, pgm);
-}
-
+  GxEPD2_DELAY(10),                   // 10ms according to specs
+  GxEPD2_CMD(0x12),                   // soft reset
+  GxEPD2_DELAY(10),                   // 10ms according to specs
+  GxEPD2_CMD(0x01, 0x27, 0x01, 0x00), // Driver output control
+  GxEPD2_CMD(0x11, 0x03),             // data entry mode
+  GxEPD2_CMD(0x3C, 0x05),             // BorderWavefrom
+  GxEPD2_CMD(0x21, 0x00, 0x80),       // Display update control
+  GxEPD2_CMD(0x18, 0x80),             // Read built-in temperature sensor
+  GxEPD2_END
+};
 
-void GxEPD2_290_T94::writeImageAgain(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+const GxEPD2_SSD168x::Descriptor GxEPD2_290_T94::descriptor =
 {
-  _writeImage(0x24, bitmap, x, y, w, h, invert, mirror_y, pgm);
-}
-
-void GxEPD2_290_T94::_writeImage(uint8_t command, const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  if (_initial_write) writeScreenBuffer(); // initial full screen buffer clean
-  delay(1); // yield() to avoid WDT on ESP8266 and ESP32
-  int16_t wb = (w + 7) / 8; // width bytes, bitmaps are padded
-  x -= x % 8; // byte boundary
-  w = wb * 8; // byte boundary
-  int16_t x1 = x < 0 ? 0 : x; // limit
-  int16_t y1 = y < 0 ? 0 : y; // limit
-  int16_t w1 = x + w < int16_t(WIDTH) ? w : int16_t(WIDTH) - x; // limit
-  int16_t h1 = y + h < int16_t(HEIGHT) ? h : int16_t(HEIGHT) - y; // limit
-  int16_t dx = x1 - x;
-  int16_t dy = y1 - y;
-  w1 -= dx;
-  h1 -= dy;
-  if ((w1 <= 0) || (h1 <= 0)) return;
-  if (!_using_partial_mode) _Init_Part();
-  _setPartialRamArea(x1, y1, w1, h1);
-  _writeCommand(command);
-  for (int16_t i = 0; i < h1; i++)
-  {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data;
-      // use wb, h of bitmap for index!
-      int16_t idx = mirror_y ? j + dx / 8 + ((h - 1 - (i + dy))) * wb : j + dx / 8 + (i + dy) * wb;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&bitmap[idx]);
-#else
-        data = bitmap[idx];
-#endif
-      }
-      else
-      {
-        data = bitmap[idx];
-      }
-      if (invert) data = ~data;
-      _writeData(data);
-    }
-  }
-  delay(1); // yield() to avoid WDT on ESP8266 and ESP32
-}
+  WIDTH, HEIGHT, panel, hasFastPartialUpdate, power_on_time, power_off_time, full_refresh_time, partial_refresh_time, init_display, 0, 0,
+  0xf8, 0x83, 0xf4, 0xfc, true
+};
 
-void GxEPD2_290_T94::writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
-                                    int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+GxEPD2_290_T94::GxEPD2_290_T94(int8_t cs, int8_t dc, int8_t rst, int8_t busy) :
+  GxEPD2_SSD168x(cs, dc, rst, busy, descriptor),
+  _grey_mode(false)
 {
-  _writeImagePart(0x24, bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
 }
 
-void GxEPD2_290_T94::writeImagePartAgain(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
-    int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+void GxEPD2_290_T94::writeImage_4G(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
 {
-  _writeImagePart(0x24, bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+  writeImagePart_4G(bitmap, 0, 0, w, h, x, y, w, h, invert, mirror_y, pgm);
 }
 
-void GxEPD2_290_T94::_writeImagePart(uint8_t command, const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
-                                     int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+void GxEPD2_290_T94::writeImagePart_4G(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                                       int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
 {
-  if (_initial_write) writeScreenBuffer(); // initial full screen buffer clean
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
   if ((w_bitmap < 0) || (h_bitmap < 0) || (w < 0) || (h < 0)) return;
   if ((x_part < 0) || (x_part >= w_bitmap)) return;
   if ((y_part < 0) || (y_part >= h_bitmap)) return;
-  int16_t wb_bitmap = (w_bitmap + 7) / 8; // width bytes, bitmaps are padded
+  int16_t wb_bitmap = 2 * ((w_bitmap + 7) / 8); // width bytes, 4 pixels per byte, bitmaps are padded
   x_part -= x_part % 8; // byte boundary
   w = w_bitmap - x_part < w ? w_bitmap - x_part : w; // limit
   h = h_bitmap - y_part < h ? h_bitmap - y_part : h; // limit
@@ -145,235 +65,108 @@ void GxEPD2_290_T94::_writeImagePart(uint8_t command, const uint8_t bitmap[], in
   w1 -= dx;
   h1 -= dy;
   if ((w1 <= 0) || (h1 <= 0)) return;
-  if (!_using_partial_mode) _Init_Part();
-  _setPartialRamArea(x1, y1, w1, h1);
-  _writeCommand(command);
-  for (int16_t i = 0; i < h1; i++)
+  if (!_grey_mode) _Init_4G();
+  // the grey level of a pixel selects the waveform by its bits in both buffers, white 00, black 11
+  static const uint8_t planes[] = {0x24, 0, 0x26, 1}; // command, grey bit
+  for (uint8_t p = 0; p < sizeof(planes); p += 2)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
+    _setPartialRamArea(x1, y1, w1, h1);
+    _writeCommand(planes[p]);
+    _startTransfer();
+    for (int16_t i = 0; i < h1; i++)
     {
-      uint8_t data;
       // use wb_bitmap, h_bitmap of bitmap for index!
-      int16_t idx = mirror_y ? x_part / 8 + j + dx / 8 + ((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + (y_part + i + dy) * wb_bitmap;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&bitmap[idx]);
-#else
-        data = bitmap[idx];
-#endif
-      }
-      else
-      {
-        data = bitmap[idx];
-      }
-      if (invert) data = ~data;
-      _writeData(data);
+      int16_t row = mirror_y ? h_bitmap - 1 - (y_part + i + dy) : y_part + i + dy;
+      _transferGreyPlane(bitmap + 2 * ((x_part + dx) / 8) + int32_t(row) * wb_bitmap, w1 / 8, planes[p + 1], !invert, pgm);
     }
+    _endTransfer();
   }
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
 }
 
-void GxEPD2_290_T94::writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  if (black)
-  {
-    writeImage(black, x, y, w, h, invert, mirror_y, pgm);
-  }
-}
-
-void GxEPD2_290_T94::writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
-                                    int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  if (black)
-  {
-    writeImagePart(black, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
-  }
-}
-
-void GxEPD2_290_T94::writeNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  if (data1)
-  {
-    writeImage(data1, x, y, w, h, invert, mirror_y, pgm);
-  }
-}
-
-void GxEPD2_290_T94::drawImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  writeImage(bitmap, x, y, w, h, invert, mirror_y, pgm);
-  refresh(x, y, w, h);
-  writeImageAgain(bitmap, x, y, w, h, invert, mirror_y, pgm);
-}
-
-void GxEPD2_290_T94::drawImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
-                                   int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  writeImagePart(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
-  refresh(x, y, w, h);
-  writeImagePartAgain(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
-}
-
-void GxEPD2_290_T94::drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  if (black)
-  {
-    drawImage(black, x, y, w, h, invert, mirror_y, pgm);
-  }
-}
-
-void GxEPD2_290_T94::drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
-                                   int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  if (black)
-  {
-    drawImagePart(black, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
-  }
-}
-
-void GxEPD2_290_T94::drawNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  if (data1)
-  {
-    drawImage(data1, x, y, w, h, invert, mirror_y, pgm);
-  }
-}
-
 void GxEPD2_290_T94::refresh(bool partial_update_mode)
 {
-  if (partial_update_mode) refresh(0, 0, WIDTH, HEIGHT);
-  else
-  {
-    if (_using_partial_mode) _Init_Full();
-    _Update_Full();
-    _initial_refresh = false; // initial full update done
-  }
+  if (_grey_mode) return _Update_4G(); // grey planes need the grey waveform, full screen
+  GxEPD2_SSD168x::refresh(partial_update_mode);
 }
 
 void GxEPD2_290_T94::refresh(int16_t x, int16_t y, int16_t w, int16_t h)
 {
-  if (_initial_refresh) return refresh(false); // initial update needs be full update
-  x -= x % 8; // byte boundary
-  w -= x % 8; // byte boundary
-  int16_t x1 = x < 0 ? 0 : x; // limit
-  int16_t y1 = y < 0 ? 0 : y; // limit
-  int16_t w1 = x + w < int16_t(WIDTH) ? w : int16_t(WIDTH) - x; // limit
-  int16_t h1 = y + h < int16_t(HEIGHT) ? h : int16_t(HEIGHT) - y; // limit
-  w1 -= x1 - x;
-  h1 -= y1 - y;
-  if (!_using_partial_mode) _Init_Part();
-  _setPartialRamArea(x1, y1, w1, h1);
-  _Update_Part();
-}
-
-void GxEPD2_290_T94::powerOff()
-{
-  _PowerOff();
-}
-
-void GxEPD2_290_T94::hibernate()
-{
-  _PowerOff();
-  if (_rst >= 0)
-  {
-    _writeCommand(0x10); // deep sleep mode
-    _writeData(0x1);     // enter deep sleep
-    _hibernating = true;
-  }
-}
-
-void GxEPD2_290_T94::_setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
-{
-  _writeCommand(0x11); // set ram entry mode
-  _writeData(0x03);    // x increase, y increase : normal mode
-  _writeCommand(0x44);
-  _writeData(x / 8);
-  _writeData((x + w - 1) / 8);
-  _writeCommand(0x45);
-  _writeData(y % 256);
-  _writeData(y / 256);
-  _writeData((y + h - 1) % 256);
-  _writeData((y + h - 1) / 256);
-  _writeCommand(0x4e);
-  _writeData(x / 8);
-  _writeCommand(0x4f);
-  _writeData(y % 256);
-  _writeData(y / 256);
-}
-
-void GxEPD2_290_T94::_PowerOn()
-{
-  if (!_power_is_on)
-  {
-    _writeCommand(0x22);
-    _writeData(0xf8);
-    _writeCommand(0x20);
-    _waitWhileBusy("_PowerOn", power_on_time);
-  }
-  _power_is_on = true;
+  if (_grey_mode) return refresh(false); // grey update is full screen
+  GxEPD2_SSD168x::refresh(x, y, w, h);
 }
 
 void GxEPD2_290_T94::_PowerOff()
 {
-  if (_power_is_on)
-  {
-    _writeCommand(0x22);
-    _writeData(0x83);
-    _writeCommand(0x20);
-    _waitWhileBusy("_PowerOff", power_off_time);
-  }
-  _power_is_on = false;
-  _using_partial_mode = false;
-}
-
-void GxEPD2_290_T94::_InitDisplay()
-{
-  if (_hibernating) _reset();
-  delay(10); // 10ms according to specs
-  _writeCommand(0x12);  //SWRESET
-  delay(10); // 10ms according to specs
-  _writeCommand(0x01); //Driver output control      
-  _writeData(0x27);
-  _writeData(0x01);
-  _writeData(0x00);
-  _writeCommand(0x11); //data entry mode       
-  _writeData(0x03);
-  _writeCommand(0x3C); //BorderWavefrom
-  _writeData(0x05);  
-  _writeCommand(0x21); //  Display update control
-  _writeData(0x00);    
-  _writeData(0x80);          
-  _writeCommand(0x18); //Read built-in temperature sensor
-  _writeData(0x80);  
-  _setPartialRamArea(0, 0, WIDTH, HEIGHT);
+  GxEPD2_SSD168x::_PowerOff();
+  _grey_mode = false;
 }
 
 void GxEPD2_290_T94::_Init_Full()
 {
-  _InitDisplay();
-  _PowerOn();
-  _using_partial_mode = false;
+  GxEPD2_SSD168x::_Init_Full();
+  _grey_mode = false;
 }
 
 void GxEPD2_290_T94::_Init_Part()
 {
-  _InitDisplay();
-  _PowerOn();
-  _using_partial_mode = true;
-}
-
-void GxEPD2_290_T94::_Update_Full()
+  GxEPD2_SSD168x::_Init_Part();
+  _grey_mode = false;
+}
+
+// 4 grey levels waveform, from the grey demo for the SSD1680 panels by Good Display and Waveshare
+// VS L0..L3 select by the bits of RAM 0x26, 0x24: white, light grey, dark grey, black
+const unsigned char GxEPD2_290_T94::lut_4G[] PROGMEM =
+{
+  0x00, 0x60, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // VS L0
+  0x20, 0x60, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // VS L1
+  0x28, 0x60, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // VS L2
+  0x2A, 0x60, 0x15, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // VS L3
+  0x00, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // VS L4 (VCOM)
+  0x00, 0x02, 0x00, 0x05, 0x14, 0x00, 0x00, // TP, SR, RP of group 0
+  0x1E, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x01, // TP, SR, RP of group 1
+  0x00, 0x02, 0x00, 0x05, 0x14, 0x00, 0x00, // TP, SR, RP of group 2
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // TP, SR, RP of group 3
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // TP, SR, RP of group 4
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // TP, SR, RP of group 5
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // TP, SR, RP of group 6
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // TP, SR, RP of group 7
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // TP, SR, RP of group 8
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // TP, SR, RP of group 9
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // TP, SR, RP of group 10
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // TP, SR, RP of group 11
+  0x24, 0x22, 0x22, 0x22, 0x23, 0x32, 0x00, 0x00, 0x00, // FR, XON
+  0x22, 0x17, 0x41, 0xAE, 0x32, 0x28 // EOPT, VGH, VSH1, VSH2, VSL, VCOM
+};
+
+void GxEPD2_290_T94::_Init_4G()
 {
-  _writeCommand(0x22);
-  _writeData(0xf4);
-  _writeCommand(0x20);
-  _waitWhileBusy("_Update_Full", full_refresh_time);
+  _InitDisplay();
+  _writeCommand(0x3C); // border waveform
+  _writeData(0x04);
+  _writeCommand(0x32); // write LUT register
+  _writeDataPGM(lut_4G, 153);
+  _writeCommand(0x3F); // end option
+  _writeDataPGM(lut_4G + 153, 1);
+  _writeCommand(0x03); // gate driving voltage
+  _writeDataPGM(lut_4G + 154, 1);
+  _writeCommand(0x04); // source driving voltage VSH1, VSH2, VSL
+  _writeDataPGM(lut_4G + 155, 3);
+  _writeCommand(0x2C); // VCOM
+  _writeDataPGM(lut_4G + 158, 1);
+  _using_partial_mode = false;
+  _grey_mode = true;
 }
 
-void GxEPD2_290_T94::_Update_Part()
+void GxEPD2_290_T94::_Update_4G()
 {
+  _statsRefresh(false);
   _writeCommand(0x22);
-  _writeData(0xfc);
+  _writeData(0xc7); // display mode 1 with LUT from register, includes analog on and off
   _writeCommand(0x20);
-  _waitWhileBusy("_Update_Part", partial_refresh_time);
+  _waitWhileBusy("_Update_4G", full_refresh_time);
+  _power_is_on = false;
+  // the buffers hold grey planes, not b/w images: clean them with the next b/w write, and refresh full
+  _initial_write = true;
+  _initial_refresh = true;
 }
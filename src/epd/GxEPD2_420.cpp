@@ -12,101 +12,154 @@
 
 #include "GxEPD2_420.h"
 
-GxEPD2_420::GxEPD2_420(int8_t cs, int8_t dc, int8_t rst, int8_t busy) :
-  GxEPD2_EPD(cs, dc, rst, busy, LOW, 10000000, WIDTH, HEIGHT, panel, hasColor, hasPartialUpdate, hasFastPartialUpdate)
+const unsigned char GxEPD2_420::init_display[] PROGMEM =
 {
-}
+  GxEPD2_CMD(0x01, 0x03, 0x00, 0x2b, 0x2b),                                // power setting, VDS_EN, VDG_EN internal, VCOM_HV, VGHL_LV=16V, VDH=11V, VDL=11V
+  GxEPD2_CMD(0x06, 0x17, 0x17, 0x17),                                      // boost soft start
+  GxEPD2_CMD(0x00, 0x3f),                                                  // panel setting, 300x400 B/W mode, LUT set by register
+  GxEPD2_CMD(0x30, 0x3a),                                                  // PLL setting, 3a 100HZ   29 150Hz 39 200HZ 31 171HZ
+  GxEPD2_CMD(0x61, WIDTH / 256, WIDTH % 256, HEIGHT / 256, HEIGHT % 256), // resolution setting
+  GxEPD2_CMD(0x82, 0x12),                                                  // vcom_DC setting, -0.1 + 18 * -0.05 = -1.0V from OTP, slightly better
+  //GxEPD2_CMD(0x82, 0x08),                                                // -0.1 + 8 * -0.05 = -0.5V from demo
+  //GxEPD2_CMD(0x82, 0x1c),                                                // -0.1 + 28 * -0.05 = -1.5V test, worse
+  GxEPD2_CMD(0x50, 0xd7),                                                  // VCOM AND DATA INTERVAL SETTING, border floating to avoid flashing
+  //GxEPD2_CMD(0x50, 0x97),                                                // WBmode:VBDF 17|D7 VBDW 97 VBDB 57   WBRmode:VBDF F7 VBDW 77 VBDB 37  VBDR B7
+  GxEPD2_END
+};
+
+const unsigned char GxEPD2_420::init_full[] PROGMEM =
+{
+  GxEPD2_CMD(0x20, // lut_20_vcom0_full
+             0x00, 0x08, 0x00, 0x00, 0x00, 0x02,
+             0x60, 0x28, 0x28, 0x00, 0x00, 0x01,
+             0x00, 0x14, 0x00, 0x00, 0x00, 0x01,
+             0x00, 0x12, 0x12, 0x00, 0x00, 0x01,
+             0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+             0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+             0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+             0x00, 0x00),
+  GxEPD2_CMD(0x21, // lut_21_ww_full
+             0x40, 0x08, 0x00, 0x00, 0x00, 0x02,
+             0x90, 0x28, 0x28, 0x00, 0x00, 0x01,
+             0x40, 0x14, 0x00, 0x00, 0x00, 0x01,
+             0xA0, 0x12, 0x12, 0x00, 0x00, 0x01,
+             0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+             0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+             0x00, 0x00, 0x00, 0x00, 0x00, 0x00),
+  GxEPD2_CMD(0x22, // lut_22_bw_full
+             0x40, 0x08, 0x00, 0x00, 0x00, 0x02,
+             0x90, 0x28, 0x28, 0x00, 0x00, 0x01,
+             0x40, 0x14, 0x00, 0x00, 0x00, 0x01,
+             0xA0, 0x12, 0x12, 0x00, 0x00, 0x01,
+             0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+             0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+             0x00, 0x00, 0x00, 0x00, 0x00, 0x00),
+  GxEPD2_CMD(0x23, // lut_23_wb_full
+             0x80, 0x08, 0x00, 0x00, 0x00, 0x02,
+             0x90, 0x28, 0x28, 0x00, 0x00, 0x01,
+             0x80, 0x14, 0x00, 0x00, 0x00, 0x01,
+             0x50, 0x12, 0x12, 0x00, 0x00, 0x01,
+             0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+             0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+             0x00, 0x00, 0x00, 0x00, 0x00, 0x00),
+  GxEPD2_CMD(0x24, // lut_24_bb_full
+             0x80, 0x08, 0x00, 0x00, 0x00, 0x02,
+             0x90, 0x28, 0x28, 0x00, 0x00, 0x01,
+             0x80, 0x14, 0x00, 0x00, 0x00, 0x01,
+             0x50, 0x12, 0x12, 0x00, 0x00, 0x01,
+             0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+             0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+             0x00, 0x00, 0x00, 0x00, 0x00, 0x00),
+  GxEPD2_END
+};
+
+// partial update waveform
+
+// same waveform as by demo code from Good Display
+//#define T1  0 // color change charge balance pre-phase
+//#define T2  0 // color change or sustain charge balance pre-phase
+//#define T3  0 // color change or sustain phase
+//#define T4 25 // color change phase
+
+// new waveform created by Jean-Marc Zingg for the actual panel
+#define T1 25 // color change charge balance pre-phase
+#define T2  1 // color change or sustain charge balance pre-phase
+#define T3  2 // color change or sustain phase
+#define T4 25 // color change phase
+
+// for new waveform without sustain phase: uncomment next 2 lines, not good for fat fonts
+//#define T2  0 // color change or sustain charge balance pre-phase // 0 no sustain
+//#define T3  0 // color change or sustain phase // 0 no sustain
+
+// "balanced flash once" variant
+//#define T1  0 // color change charge balance pre-phase
+//#define T2 25 // color change or sustain charge balance pre-phase
+//#define T3 25 // color change or sustain phase
+//#define T4  0 // color change phase
+
+const unsigned char GxEPD2_420::lut_20_vcom0_partial[] PROGMEM =
+{
+  0x00, T1, T2, T3, T4, 1, // 00 00 00 00
+  0x00,  1,  0,  0,  0, 1, // gnd phase
+};
+
+const unsigned char GxEPD2_420::lut_21_ww_partial[] PROGMEM =
+{ // 10 w
+  0x18, T1, T2, T3, T4, 1, // 00 01 10 00
+  0x00,  1,  0,  0,  0, 1, // gnd phase
+};
+
+const unsigned char GxEPD2_420::lut_22_bw_partial[] PROGMEM =
+{ // 10 w
+  0x5A, T1, T2, T3, T4, 1, // 01 01 10 10
+  0x00,  1,  0,  0,  0, 1, // gnd phase
+};
+
+const unsigned char GxEPD2_420::lut_23_wb_partial[] PROGMEM =
+{ // 01 b
+  0xA5, T1, T2, T3, T4, 1, // 10 10 01 01
+  0x00,  1,  0,  0,  0, 1, // gnd phase
+};
+
+const unsigned char GxEPD2_420::lut_24_bb_partial[] PROGMEM =
+{ // 01 b
+  0x24, T1, T2, T3, T4, 1, // 00 10 01 00
+  0x00,  1,  0,  0,  0, 1, // gnd phase
+};
+
+const GxEPD2_UC8151::Descriptor GxEPD2_420::descriptor =
+{
+  WIDTH, HEIGHT, panel, hasFastPartialUpdate, power_on_time, power_off_time, full_refresh_time, partial_refresh_time, init_display, init_full, 0,
+  sizeof(lut_20_vcom0_partial), {lut_20_vcom0_partial, lut_21_ww_partial, lut_22_bw_partial, lut_23_wb_partial, lut_24_bb_partial}, usePartialUpdateWindow, true
+};
 
-void GxEPD2_420::clearScreen(uint8_t value)
+GxEPD2_420::GxEPD2_420(int8_t cs, int8_t dc, int8_t rst, int8_t busy) :
+  GxEPD2_UC8151(cs, dc, rst, busy, descriptor),
+  _grey_mode(false)
 {
-  writeScreenBuffer(value);
-  refresh(true);
-  writeScreenBuffer(value);
 }
 
 void GxEPD2_420::writeScreenBuffer(uint8_t value)
 {
   _initial_write = false; // initial full screen buffer clean done
   if (!_using_partial_mode) _Init_Part();
-  if (_initial_refresh)
-  {
-    _writeCommand(0x10); // init old data
-    _startTransfer();
-    for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-    {
-      _transfer(value);
-    }
-    _endTransfer();
-  }
-  _writeCommand(0x13);
-  _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _transfer(value);
-  }
-  _endTransfer();
+  if (_initial_refresh) _writeScreenBuffer(0x10, value); // init old data
+  _writeScreenBuffer(0x13, value);
 }
 
-void GxEPD2_420::writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+void GxEPD2_420::writeImage_4G(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
 {
-  if (_initial_write) writeScreenBuffer(); // initial full screen buffer clean
-  delay(1); // yield() to avoid WDT on ESP8266 and ESP32
-  int16_t wb = (w + 7) / 8; // width bytes, bitmaps are padded
-  x -= x % 8; // byte boundary
-  w = wb * 8; // byte boundary
-  int16_t x1 = x < 0 ? 0 : x; // limit
-  int16_t y1 = y < 0 ? 0 : y; // limit
-  int16_t w1 = x + w < int16_t(WIDTH) ? w : int16_t(WIDTH) - x; // limit
-  int16_t h1 = y + h < int16_t(HEIGHT) ? h : int16_t(HEIGHT) - y; // limit
-  int16_t dx = x1 - x;
-  int16_t dy = y1 - y;
-  w1 -= dx;
-  h1 -= dy;
-  if ((w1 <= 0) || (h1 <= 0)) return;
-  if (!_using_partial_mode) _Init_Part();
-  //uint32_t start = micros();
-  _writeCommand(0x91); // partial in
-  _setPartialRamArea(x1, y1, w1, h1);
-  _writeCommand(0x13);
-  _startTransfer();
-  for (int16_t i = 0; i < h1; i++)
-  {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data;
-      // use wb, h of bitmap for index!
-      int16_t idx = mirror_y ? j + dx / 8 + ((h - 1 - (i + dy))) * wb : j + dx / 8 + (i + dy) * wb;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&bitmap[idx]);
-#else
-        data = bitmap[idx];
-#endif
-      }
-      else
-      {
-        data = bitmap[idx];
-      }
-      if (invert) data = ~data;
-      _transfer(data);
-    }
-  }
-  _endTransfer();
-  _writeCommand(0x92); // partial out
-  //Serial.print("GxEPD2_420::writeImage took "); Serial.println(micros() - start);
-  delay(1); // yield() to avoid WDT on ESP8266 and ESP32
+  writeImagePart_4G(bitmap, 0, 0, w, h, x, y, w, h, invert, mirror_y, pgm);
 }
 
-void GxEPD2_420::writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
-                                int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+void GxEPD2_420::writeImagePart_4G(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                                   int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
 {
-  if (_initial_write) writeScreenBuffer(); // initial full screen buffer clean
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
   if ((w_bitmap < 0) || (h_bitmap < 0) || (w < 0) || (h < 0)) return;
   if ((x_part < 0) || (x_part >= w_bitmap)) return;
   if ((y_part < 0) || (y_part >= h_bitmap)) return;
-  int16_t wb_bitmap = (w_bitmap + 7) / 8; // width bytes, bitmaps are padded
+  int16_t wb_bitmap = 2 * ((w_bitmap + 7) / 8); // width bytes, 4 pixels per byte, bitmaps are padded
   x_part -= x_part % 8; // byte boundary
   w = w_bitmap - x_part < w ? w_bitmap - x_part : w; // limit
   h = h_bitmap - y_part < h ? h_bitmap - y_part : h; // limit
@@ -121,364 +174,139 @@ void GxEPD2_420::writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t
   w1 -= dx;
   h1 -= dy;
   if ((w1 <= 0) || (h1 <= 0)) return;
-  if (!_using_partial_mode) _Init_Part();
+  if (!_grey_mode) _Init_4G();
+  // the grey level of a pixel selects the waveform by its bits in old and new data, white ww, black bb
+  static const uint8_t planes[] = {0x10, 1, 0x13, 0}; // command, grey bit
   _writeCommand(0x91); // partial in
   _setPartialRamArea(x1, y1, w1, h1);
-  _writeCommand(0x13);
-  _startTransfer();
-  for (int16_t i = 0; i < h1; i++)
+  for (uint8_t p = 0; p < sizeof(planes); p += 2)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
+    _writeCommand(planes[p]);
+    _startTransfer();
+    for (int16_t i = 0; i < h1; i++)
     {
-      uint8_t data;
       // use wb_bitmap, h_bitmap of bitmap for index!
-      int16_t idx = mirror_y ? x_part / 8 + j + dx / 8 + ((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + (y_part + i + dy) * wb_bitmap;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&bitmap[idx]);
-#else
-        data = bitmap[idx];
-#endif
-      }
-      else
-      {
-        data = bitmap[idx];
-      }
-      if (invert) data = ~data;
-      _transfer(data);
+      int16_t row = mirror_y ? h_bitmap - 1 - (y_part + i + dy) : y_part + i + dy;
+      _transferGreyPlane(bitmap + 2 * ((x_part + dx) / 8) + int32_t(row) * wb_bitmap, w1 / 8, planes[p + 1], invert, pgm);
     }
+    _endTransfer();
   }
-  _endTransfer();
   _writeCommand(0x92); // partial out
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
 }
 
-void GxEPD2_420::writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  if (black)
-  {
-    writeImage(black, x, y, w, h, invert, mirror_y, pgm);
-  }
-}
-
-void GxEPD2_420::writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
-                                int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  if (black)
-  {
-    writeImagePart(black, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
-  }
-}
-
-void GxEPD2_420::writeNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  if (data1)
-  {
-    writeImage(data1, x, y, w, h, invert, mirror_y, pgm);
-  }
-}
-
-void GxEPD2_420::drawImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  writeImage(bitmap, x, y, w, h, invert, mirror_y, pgm);
-  refresh(x, y, w, h);
-  writeImage(bitmap, x, y, w, h, invert, mirror_y, pgm);
-}
-
-void GxEPD2_420::drawImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
-                               int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  writeImagePart(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
-  refresh(x, y, w, h);
-  writeImagePart(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
-}
-
-void GxEPD2_420::drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  writeImage(black, color, x, y, w, h, invert, mirror_y, pgm);
-  refresh(x, y, w, h);
-  writeImage(black, color, x, y, w, h, invert, mirror_y, pgm);
-}
-
-void GxEPD2_420::drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
-                               int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
-  refresh(x, y, w, h);
-  writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
-}
-
-void GxEPD2_420::drawNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  writeNative(data1, data2, x, y, w, h, invert, mirror_y, pgm);
-  refresh(x, y, w, h);
-  writeNative(data1, data2, x, y, w, h, invert, mirror_y, pgm);
-}
-
 void GxEPD2_420::refresh(bool partial_update_mode)
 {
-  if (partial_update_mode) refresh(0, 0, WIDTH, HEIGHT);
-  else
-  {
-    if (_using_partial_mode) _Init_Full();
-    _Update_Full();
-    _initial_refresh = false; // initial full update done
-  }
+  if (_grey_mode) return _Update_4G(); // grey planes need the grey waveform, full screen
+  GxEPD2_UC8151::refresh(partial_update_mode);
 }
 
 void GxEPD2_420::refresh(int16_t x, int16_t y, int16_t w, int16_t h)
 {
-  if (_initial_refresh) return refresh(false); // initial update needs be full update
-  x -= x % 8; // byte boundary
-  w -= x % 8; // byte boundary
-  int16_t x1 = x < 0 ? 0 : x; // limit
-  int16_t y1 = y < 0 ? 0 : y; // limit
-  int16_t w1 = x + w < int16_t(WIDTH) ? w : int16_t(WIDTH) - x; // limit
-  int16_t h1 = y + h < int16_t(HEIGHT) ? h : int16_t(HEIGHT) - y; // limit
-  w1 -= x1 - x;
-  h1 -= y1 - y;
-  if (!_using_partial_mode) _Init_Part();
-  if (usePartialUpdateWindow) _writeCommand(0x91); // partial in
-  _setPartialRamArea(x1, y1, w1, h1);
-  _Update_Part();
-  if (usePartialUpdateWindow) _writeCommand(0x92); // partial out
-}
-
-void GxEPD2_420::powerOff(void)
-{
-  _PowerOff();
-}
-
-void GxEPD2_420::hibernate()
-{
-  _PowerOff();
-  if (_rst >= 0)
-  {
-    _writeCommand(0x07); // deep sleep
-    _writeData(0xA5);    // check code
-    _hibernating = true;
-  }
+  if (_grey_mode) return refresh(false); // grey update is full screen
+  GxEPD2_UC8151::refresh(x, y, w, h);
 }
 
-void GxEPD2_420::_setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+void GxEPD2_420::_PowerOff()
 {
-  uint16_t xe = (x + w - 1) | 0x0007; // byte boundary inclusive (last byte)
-  uint16_t ye = y + h - 1;
-  x &= 0xFFF8; // byte boundary
-  _writeCommand(0x90); // partial window
-  _writeData(x / 256);
-  _writeData(x % 256);
-  _writeData(xe / 256);
-  _writeData(xe % 256);
-  _writeData(y / 256);
-  _writeData(y % 256);
-  _writeData(ye / 256);
-  _writeData(ye % 256);
-  _writeData(0x01); // don't see any difference
-  //_writeData(0x00); // don't see any difference
+  GxEPD2_UC8151::_PowerOff();
+  _grey_mode = false;
 }
 
-void GxEPD2_420::_PowerOn()
+void GxEPD2_420::_Init_Full()
 {
-  if (!_power_is_on)
-  {
-    _writeCommand(0x04);
-    _waitWhileBusy("_PowerOn", power_on_time);
-  }
-  _power_is_on = true;
+  GxEPD2_UC8151::_Init_Full();
+  _grey_mode = false;
 }
 
-void GxEPD2_420::_PowerOff()
+void GxEPD2_420::_Init_Part()
 {
-  _writeCommand(0x02); // power off
-  _waitWhileBusy("_PowerOff", power_off_time);
-  _power_is_on = false;
-  _using_partial_mode = false;
+  GxEPD2_UC8151::_Init_Part();
+  _grey_mode = false;
 }
 
-void GxEPD2_420::_InitDisplay()
-{
-  if (_hibernating) _reset();
-  _writeCommand(0x01); // POWER SETTING
-  _writeData (0x03);   // VDS_EN, VDG_EN internal
-  _writeData (0x00);   // VCOM_HV, VGHL_LV=16V
-  _writeData (0x2b);   // VDH=11V
-  _writeData (0x2b);   // VDL=11V
-  _writeCommand(0x06); // boost soft start
-  _writeData (0x17);   // A
-  _writeData (0x17);   // B
-  _writeData (0x17);   // C
-  _writeCommand(0x00); // panel setting
-  _writeData(0x3f);    // 300x400 B/W mode, LUT set by register
-  _writeCommand(0x30); // PLL setting
-  _writeData (0x3a);   // 3a 100HZ   29 150Hz 39 200HZ 31 171HZ
-  _writeCommand(0x61); // resolution setting
-  _writeData (WIDTH / 256);
-  _writeData (WIDTH % 256);
-  _writeData (HEIGHT / 256);
-  _writeData (HEIGHT % 256);
-  _writeCommand(0x82); // vcom_DC setting
-  //_writeData (0x08);   // -0.1 + 8 * -0.05 = -0.5V from demo
-  _writeData (0x12);   // -0.1 + 18 * -0.05 = -1.0V from OTP, slightly better
-  //_writeData (0x1c);   // -0.1 + 28 * -0.05 = -1.5V test, worse
-  _writeCommand(0x50); // VCOM AND DATA INTERVAL SETTING
-  //_writeData(0x97);    // WBmode:VBDF 17|D7 VBDW 97 VBDB 57   WBRmode:VBDF F7 VBDW 77 VBDB 37  VBDR B7
-  _writeData(0xd7);    // border floating to avoid flashing
-}
+// 4 grey levels waveform, from the grey demo for this panel by Good Display and Waveshare
+// old and new data bits select the LUT: ww white, wb light grey, bw dark grey, bb black
 
-const unsigned char GxEPD2_420::lut_20_vcom0_full[] PROGMEM =
+const unsigned char GxEPD2_420::lut_20_vcom0_4G[] PROGMEM =
 {
-  0x00, 0x08, 0x00, 0x00, 0x00, 0x02,
-  0x60, 0x28, 0x28, 0x00, 0x00, 0x01,
+  0x00, 0x0A, 0x00, 0x00, 0x00, 0x01,
+  0x60, 0x14, 0x14, 0x00, 0x00, 0x01,
   0x00, 0x14, 0x00, 0x00, 0x00, 0x01,
-  0x00, 0x12, 0x12, 0x00, 0x00, 0x01,
+  0x00, 0x13, 0x0A, 0x01, 0x00, 0x01,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
-const unsigned char GxEPD2_420::lut_21_ww_full[] PROGMEM =
+const unsigned char GxEPD2_420::lut_21_ww_4G[] PROGMEM =
 {
-  0x40, 0x08, 0x00, 0x00, 0x00, 0x02,
-  0x90, 0x28, 0x28, 0x00, 0x00, 0x01,
-  0x40, 0x14, 0x00, 0x00, 0x00, 0x01,
-  0xA0, 0x12, 0x12, 0x00, 0x00, 0x01,
+  0x40, 0x0A, 0x00, 0x00, 0x00, 0x01,
+  0x90, 0x14, 0x14, 0x00, 0x00, 0x01,
+  0x10, 0x14, 0x0A, 0x00, 0x00, 0x01,
+  0xA0, 0x13, 0x01, 0x00, 0x00, 0x01,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
-const unsigned char GxEPD2_420::lut_22_bw_full[] PROGMEM =
+const unsigned char GxEPD2_420::lut_22_bw_4G[] PROGMEM =
 {
-  0x40, 0x08, 0x00, 0x00, 0x00, 0x02,
-  0x90, 0x28, 0x28, 0x00, 0x00, 0x01,
-  0x40, 0x14, 0x00, 0x00, 0x00, 0x01,
-  0xA0, 0x12, 0x12, 0x00, 0x00, 0x01,
+  0x40, 0x0A, 0x00, 0x00, 0x00, 0x01,
+  0x90, 0x14, 0x14, 0x00, 0x00, 0x01,
+  0x00, 0x14, 0x0A, 0x00, 0x00, 0x01,
+  0x99, 0x0C, 0x01, 0x03, 0x04, 0x01,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
-const unsigned char GxEPD2_420::lut_23_wb_full[] PROGMEM =
+const unsigned char GxEPD2_420::lut_23_wb_4G[] PROGMEM =
 {
-  0x80, 0x08, 0x00, 0x00, 0x00, 0x02,
-  0x90, 0x28, 0x28, 0x00, 0x00, 0x01,
-  0x80, 0x14, 0x00, 0x00, 0x00, 0x01,
-  0x50, 0x12, 0x12, 0x00, 0x00, 0x01,
+  0x40, 0x0A, 0x00, 0x00, 0x00, 0x01,
+  0x90, 0x14, 0x14, 0x00, 0x00, 0x01,
+  0x00, 0x14, 0x0A, 0x00, 0x00, 0x01,
+  0x99, 0x0B, 0x04, 0x04, 0x01, 0x01,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
-const unsigned char GxEPD2_420::lut_24_bb_full[] PROGMEM =
+const unsigned char GxEPD2_420::lut_24_bb_4G[] PROGMEM =
 {
-  0x80, 0x08, 0x00, 0x00, 0x00, 0x02,
-  0x90, 0x28, 0x28, 0x00, 0x00, 0x01,
-  0x80, 0x14, 0x00, 0x00, 0x00, 0x01,
-  0x50, 0x12, 0x12, 0x00, 0x00, 0x01,
+  0x80, 0x0A, 0x00, 0x00, 0x00, 0x01,
+  0x90, 0x14, 0x14, 0x00, 0x00, 0x01,
+  0x20, 0x14, 0x0A, 0x00, 0x00, 0x01,
+  0x50, 0x13, 0x01, 0x00, 0x00, 0x01,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
-// partial update waveform
-
-// same waveform as by demo code from Good Display
-//#define T1  0 // color change charge balance pre-phase
-//#define T2  0 // color change or sustain charge balance pre-phase
-//#define T3  0 // color change or sustain phase
-//#define T4 25 // color change phase
-
-// new waveform created by Jean-Marc Zingg for the actual panel
-#define T1 25 // color change charge balance pre-phase
-#define T2  1 // color change or sustain charge balance pre-phase
-#define T3  2 // color change or sustain phase
-#define T4 25 // color change phase
-
-// for new waveform without sustain phase: uncomment next 2 lines, not good for fat fonts
-//#define T2  0 // color change or sustain charge balance pre-phase // 0 no sustain
-//#define T3  0 // color change or sustain phase // 0 no sustain
-
-// "balanced flash once" variant
-//#define T1  0 // color change charge balance pre-phase
-//#define T2 25 // color change or sustain charge balance pre-phase
-//#define T3 25 // color change or sustain phase
-//#define T4  0 // color change phase
-
-const unsigned char GxEPD2_420::lut_20_vcom0_partial[] PROGMEM =
-{
-  0x00, T1, T2, T3, T4, 1, // 00 00 00 00
-  0x00,  1,  0,  0,  0, 1, // gnd phase
-};
-
-const unsigned char GxEPD2_420::lut_21_ww_partial[] PROGMEM =
-{ // 10 w
-  0x18, T1, T2, T3, T4, 1, // 00 01 10 00
-  0x00,  1,  0,  0,  0, 1, // gnd phase
-};
-
-const unsigned char GxEPD2_420::lut_22_bw_partial[] PROGMEM =
-{ // 10 w
-  0x5A, T1, T2, T3, T4, 1, // 01 01 10 10
-  0x00,  1,  0,  0,  0, 1, // gnd phase
-};
-
-const unsigned char GxEPD2_420::lut_23_wb_partial[] PROGMEM =
-{ // 01 b
-  0xA5, T1, T2, T3, T4, 1, // 10 10 01 01
-  0x00,  1,  0,  0,  0, 1, // gnd phase
-};
-
-const unsigned char GxEPD2_420::lut_24_bb_partial[] PROGMEM =
-{ // 01 b
-  0x24, T1, T2, T3, T4, 1, // 00 10 01 00
-  0x00,  1,  0,  0,  0, 1, // gnd phase
-};
-
-void GxEPD2_420::_Init_Full()
+void GxEPD2_420::_Init_4G()
 {
   _InitDisplay();
   _writeCommand(0x20);
-  _writeDataPGM(lut_20_vcom0_full, sizeof(lut_20_vcom0_full));
+  _writeDataPGM(lut_20_vcom0_4G, sizeof(lut_20_vcom0_4G), 44 - sizeof(lut_20_vcom0_4G));
   _writeCommand(0x21);
-  _writeDataPGM(lut_21_ww_full, sizeof(lut_21_ww_full));
+  _writeDataPGM(lut_21_ww_4G, sizeof(lut_21_ww_4G));
   _writeCommand(0x22);
-  _writeDataPGM(lut_22_bw_full, sizeof(lut_22_bw_full));
+  _writeDataPGM(lut_22_bw_4G, sizeof(lut_22_bw_4G));
   _writeCommand(0x23);
-  _writeDataPGM(lut_23_wb_full, sizeof(lut_23_wb_full));
+  _writeDataPGM(lut_23_wb_4G, sizeof(lut_23_wb_4G));
   _writeCommand(0x24);
-  _writeDataPGM(lut_24_bb_full, sizeof(lut_24_bb_full));
+  _writeDataPGM(lut_24_bb_4G, sizeof(lut_24_bb_4G));
   _PowerOn();
   _using_partial_mode = false;
+  _grey_mode = true;
 }
 
-void GxEPD2_420::_Init_Part()
-{
-  _InitDisplay();
-  _writeCommand(0x20);
-  _writeDataPGM(lut_20_vcom0_partial, sizeof(lut_20_vcom0_partial), 44 - sizeof(lut_20_vcom0_partial));
-  _writeCommand(0x21);
-  _writeDataPGM(lut_21_ww_partial, sizeof(lut_21_ww_partial), 42 - sizeof(lut_21_ww_partial));
-  _writeCommand(0x22);
-  _writeDataPGM(lut_22_bw_partial, sizeof(lut_22_bw_partial), 42 - sizeof(lut_22_bw_partial));
-  _writeCommand(0x23);
-  _writeDataPGM(lut_23_wb_partial, sizeof(lut_23_wb_partial), 42 - sizeof(lut_23_wb_partial));
-  _writeCommand(0x24);
-  _writeDataPGM(lut_24_bb_partial, sizeof(lut_24_bb_partial), 42 - sizeof(lut_24_bb_partial));
-  _PowerOn();
-  _using_partial_mode = true;
-}
-
-void GxEPD2_420::_Update_Full()
-{
-  _writeCommand(0x12); //display refresh
-  _waitWhileBusy("_Update_Full", full_refresh_time);
-}
-
-void GxEPD2_420::_Update_Part()
+void GxEPD2_420::_Update_4G()
 {
+  _statsRefresh(false);
   _writeCommand(0x12); //display refresh
-  _waitWhileBusy("_Update_Part", partial_refresh_time);
+  _waitWhileBusy("_Update_4G", full_refresh_time);
+  // the buffers hold grey planes, not b/w images: clean them with the next b/w write, and refresh full
+  _initial_write = true;
+  _initial_refresh = true;
 }
@@ -0,0 +1,65 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// common base of the b/w panels with controller SSD1675 (IL3897), e.g. GxEPD2_213_B72, GxEPD2_213_B73
+// Controller: SSD1675B : http://www.e-paper-display.com/download_detail/downloadsId=820.html
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#include "GxEPD2_SSD1675.h"
+
+GxEPD2_SSD1675::GxEPD2_SSD1675(int8_t cs, int8_t dc, int8_t rst, int8_t busy, const Descriptor& descriptor) :
+  GxEPD2_SSD168x(cs, dc, rst, busy, descriptor)
+{
+}
+
+void GxEPD2_SSD1675::writeScreenBuffer(uint8_t value)
+{
+  _initial_write = false; // initial full screen buffer clean done
+  if (!_using_partial_mode) _Init_Part();
+  _setPartialRamArea(0, 0, WIDTH, HEIGHT);
+  _writeScreenBuffer(0x24, value); // set current
+  if (_initial_refresh) writeScreenBufferAgain(value); // init "old data"
+}
+
+void GxEPD2_SSD1675::writeScreenBufferAgain(uint8_t value)
+{
+  if (!_using_partial_mode) _Init_Part();
+  _setPartialRamArea(0, 0, WIDTH, HEIGHT);
+  _writeScreenBuffer(0x26, value); // set previous
+}
+
+void GxEPD2_SSD1675::writeImageForFullRefresh(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  writeImage(bitmap, x, y, w, h, invert, mirror_y, pgm); // full refresh doesn't need the previous buffer
+}
+
+void GxEPD2_SSD1675::writeImageAgain(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  _writeImage(0x26, bitmap, x, y, w, h, invert, mirror_y, pgm);
+}
+
+void GxEPD2_SSD1675::writeImagePartAgain(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+    int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  _writeImagePart(0x26, bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+}
+
+void GxEPD2_SSD1675::_PowerOff()
+{
+  _writeCommand(0x22);
+  _writeData(_descriptor.power_off_control);
+  _writeCommand(0x20);
+  _waitWhileBusy("_PowerOff", _descriptor.power_off_time);
+  _power_is_on = false;
+  _using_partial_mode = false;
+}
+
+bool GxEPD2_SSD1675::_startRotatedWrite(uint8_t rotation, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+  return false; // not verified on SSD1675 panels, writeImageRotated() transposes
+}
@@ -0,0 +1,40 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// common base of the b/w panels with controller SSD1675 (IL3897), e.g. GxEPD2_213_B72, GxEPD2_213_B73
+// Controller: SSD1675B : http://www.e-paper-display.com/download_detail/downloadsId=820.html
+//
+// the controller does not switch buffers on refresh: the ...Again() methods write the previous buffer (0x26),
+// the rest of the driver is GxEPD2_SSD168x, with the LUTs and update sequences in the Descriptor of the panel
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#ifndef _GxEPD2_SSD1675_H_
+#define _GxEPD2_SSD1675_H_
+
+#include "GxEPD2_SSD168x.h"
+
+class GxEPD2_SSD1675 : public GxEPD2_SSD168x
+{
+  public:
+    // constructor
+    GxEPD2_SSD1675(int8_t cs, int8_t dc, int8_t rst, int8_t busy, const Descriptor& descriptor);
+    // methods (virtual)
+    void writeScreenBuffer(uint8_t value = 0xFF); // init controller memory (default white)
+    void writeScreenBufferAgain(uint8_t value = 0xFF); // init previous buffer controller memory (default white)
+    void writeImageForFullRefresh(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    // for differential update: set current and previous buffers equal (for fast partial update to work correctly)
+    void writeImageAgain(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void writeImagePartAgain(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                             int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+  protected:
+    void _PowerOff();
+  private:
+    bool _startRotatedWrite(uint8_t rotation, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+};
+
+#endif
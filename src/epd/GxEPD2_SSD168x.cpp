@@ -0,0 +1,372 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// common base of the b/w panels with controllers SSD1680 and SSD1681, e.g. GxEPD2_154_D67, GxEPD2_290_T94,
+// and through GxEPD2_SSD1675 of the panels with controller SSD1675 (IL3897), e.g. GxEPD2_213_B72, GxEPD2_213_B73
+// Controller : SSD1680 : https://www.good-display.com/companyfile/101.html
+// Controller : SSD1681 : http://www.e-paper-display.com/download_detail/downloadsId=825.html
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#include "GxEPD2_SSD168x.h"
+
+GxEPD2_SSD168x::GxEPD2_SSD168x(int8_t cs, int8_t dc, int8_t rst, int8_t busy, const Descriptor& descriptor) :
+  GxEPD2_EPD(cs, dc, rst, busy, HIGH, 10000000, descriptor.width, descriptor.height, descriptor.panel, false, true, descriptor.hasFastPartialUpdate),
+  _descriptor(descriptor)
+{
+}
+
+void GxEPD2_SSD168x::clearScreen(uint8_t value)
+{
+  writeScreenBuffer(value);
+  refresh(true);
+  writeScreenBufferAgain(value);
+}
+
+void GxEPD2_SSD168x::writeScreenBuffer(uint8_t value)
+{
+  if (!_using_partial_mode) _Init_Part();
+  if (_initial_write) _writeScreenBuffer(0x26, value); // set previous
+  _writeScreenBuffer(0x24, value); // set current
+  _initial_write = false; // initial full screen buffer clean done
+}
+
+void GxEPD2_SSD168x::writeScreenBufferAgain(uint8_t value)
+{
+  if (!_using_partial_mode) _Init_Part();
+  _writeScreenBuffer(0x24, value); // set current
+}
+
+void GxEPD2_SSD168x::_writeScreenBuffer(uint8_t command, uint8_t value)
+{
+  _writeCommand(command);
+  _startTransfer();
+  _transferFill(value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
+  _endTransfer();
+}
+
+void GxEPD2_SSD168x::writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  _writeImage(0x24, bitmap, x, y, w, h, invert, mirror_y, pgm);
+}
+
+void GxEPD2_SSD168x::writeImageForFullRefresh(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  _writeImage(0x26, bitmap, x, y, w, h, invert, mirror_y, pgm);
+  _writeImage(0x24, bitmap, x, y, w, h, invert, mirror_y, pgm);
+}
+
+void GxEPD2_SSD168x::writeImageAgain(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  _writeImage(0x24, bitmap, x, y, w, h, invert, mirror_y, pgm);
+}
+
+void GxEPD2_SSD168x::_writeImage(uint8_t command, const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  if (_initial_write) writeScreenBuffer(); // initial full screen buffer clean
+  delay(1); // yield() to avoid WDT on ESP8266 and ESP32
+  int16_t wb = (w + 7) / 8; // width bytes, bitmaps are padded
+  x -= x % 8; // byte boundary
+  w = wb * 8; // byte boundary
+  int16_t x1 = x < 0 ? 0 : x; // limit
+  int16_t y1 = y < 0 ? 0 : y; // limit
+  int16_t w1 = x + w < int16_t(WIDTH) ? w : int16_t(WIDTH) - x; // limit
+  int16_t h1 = y + h < int16_t(HEIGHT) ? h : int16_t(HEIGHT) - y; // limit
+  int16_t dx = x1 - x;
+  int16_t dy = y1 - y;
+  w1 -= dx;
+  h1 -= dy;
+  if ((w1 <= 0) || (h1 <= 0)) return;
+  if (!_using_partial_mode) _Init_Part();
+  _setPartialRamArea(x1, y1, w1, h1);
+  _writeCommand(command);
+  _startTransfer();
+  _transferRows(bitmap, wb, h, dx / 8, dy, w1 / 8, h1, invert, mirror_y, pgm);
+  _endTransfer();
+  delay(1); // yield() to avoid WDT on ESP8266 and ESP32
+}
+
+void GxEPD2_SSD168x::writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                                    int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  _writeImagePart(0x24, bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+}
+
+void GxEPD2_SSD168x::writeImagePartAgain(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+    int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  _writeImagePart(0x24, bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+}
+
+void GxEPD2_SSD168x::_writeImagePart(uint8_t command, const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                                     int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  if (_initial_write) writeScreenBuffer(); // initial full screen buffer clean
+  delay(1); // yield() to avoid WDT on ESP8266 and ESP32
+  if ((w_bitmap < 0) || (h_bitmap < 0) || (w < 0) || (h < 0)) return;
+  if ((x_part < 0) || (x_part >= w_bitmap)) return;
+  if ((y_part < 0) || (y_part >= h_bitmap)) return;
+  int16_t wb_bitmap = (w_bitmap + 7) / 8; // width bytes, bitmaps are padded
+  x_part -= x_part % 8; // byte boundary
+  w = w_bitmap - x_part < w ? w_bitmap - x_part : w; // limit
+  h = h_bitmap - y_part < h ? h_bitmap - y_part : h; // limit
+  x -= x % 8; // byte boundary
+  w = 8 * ((w + 7) / 8); // byte boundary, bitmaps are padded
+  int16_t x1 = x < 0 ? 0 : x; // limit
+  int16_t y1 = y < 0 ? 0 : y; // limit
+  int16_t w1 = x + w < int16_t(WIDTH) ? w : int16_t(WIDTH) - x; // limit
+  int16_t h1 = y + h < int16_t(HEIGHT) ? h : int16_t(HEIGHT) - y; // limit
+  int16_t dx = x1 - x;
+  int16_t dy = y1 - y;
+  w1 -= dx;
+  h1 -= dy;
+  if ((w1 <= 0) || (h1 <= 0)) return;
+  if (!_using_partial_mode) _Init_Part();
+  _setPartialRamArea(x1, y1, w1, h1);
+  _writeCommand(command);
+  _startTransfer();
+  _transferRows(bitmap, wb_bitmap, h_bitmap, x_part / 8 + dx / 8, y_part + dy, w1 / 8, h1, invert, mirror_y, pgm);
+  _endTransfer();
+  delay(1); // yield() to avoid WDT on ESP8266 and ESP32
+}
+
+void GxEPD2_SSD168x::writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  if (black)
+  {
+    writeImage(black, x, y, w, h, invert, mirror_y, pgm);
+  }
+}
+
+void GxEPD2_SSD168x::writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                                    int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  if (black)
+  {
+    writeImagePart(black, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+  }
+}
+
+void GxEPD2_SSD168x::writeNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  if (data1)
+  {
+    writeImage(data1, x, y, w, h, invert, mirror_y, pgm);
+  }
+}
+
+void GxEPD2_SSD168x::drawImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  writeImage(bitmap, x, y, w, h, invert, mirror_y, pgm);
+  refresh(x, y, w, h);
+  writeImageAgain(bitmap, x, y, w, h, invert, mirror_y, pgm);
+}
+
+void GxEPD2_SSD168x::drawImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                                   int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  writeImagePart(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+  refresh(x, y, w, h);
+  writeImagePartAgain(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+}
+
+void GxEPD2_SSD168x::drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  if (black)
+  {
+    drawImage(black, x, y, w, h, invert, mirror_y, pgm);
+  }
+}
+
+void GxEPD2_SSD168x::drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                                   int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  if (black)
+  {
+    drawImagePart(black, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+  }
+}
+
+void GxEPD2_SSD168x::drawNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  if (data1)
+  {
+    drawImage(data1, x, y, w, h, invert, mirror_y, pgm);
+  }
+}
+
+void GxEPD2_SSD168x::refresh(bool partial_update_mode)
+{
+  if (partial_update_mode) refresh(0, 0, WIDTH, HEIGHT);
+  else
+  {
+    if (_using_partial_mode) _Init_Full();
+    _Update_Full();
+    _initial_refresh = false; // initial full update done
+  }
+}
+
+void GxEPD2_SSD168x::refresh(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  if (_initial_refresh) return refresh(false); // initial update needs be full update
+  x -= x % 8; // byte boundary
+  w -= x % 8; // byte boundary
+  int16_t x1 = x < 0 ? 0 : x; // limit
+  int16_t y1 = y < 0 ? 0 : y; // limit
+  int16_t w1 = x + w < int16_t(WIDTH) ? w : int16_t(WIDTH) - x; // limit
+  int16_t h1 = y + h < int16_t(HEIGHT) ? h : int16_t(HEIGHT) - y; // limit
+  w1 -= x1 - x;
+  h1 -= y1 - y;
+  if (!_using_partial_mode) _Init_Part();
+  _setPartialRamArea(x1, y1, w1, h1);
+  _Update_Part();
+}
+
+void GxEPD2_SSD168x::powerOff()
+{
+  _PowerOff();
+}
+
+void GxEPD2_SSD168x::hibernate()
+{
+  _PowerOff();
+  if (_rst >= 0)
+  {
+    _writeCommand(0x10); // deep sleep mode
+    _writeData(0x1);     // enter deep sleep
+    _hibernating = true;
+  }
+}
+
+// entry_mode : bit 0 x increase, bit 1 y increase, bit 2 address counter in y direction; 0x03 is normal mode
+// the window is set from start to end in the direction of entry_mode, the address counter to its start
+void GxEPD2_SSD168x::_setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t entry_mode)
+{
+  uint16_t xs = x / 8, xe = (x + w - 1) / 8, ys = y, ye = y + h - 1;
+  if (!(entry_mode & 0x01)) // x decrease
+  {
+    xs = xe;
+    xe = x / 8;
+  }
+  if (!(entry_mode & 0x02)) // y decrease
+  {
+    ys = ye;
+    ye = y;
+  }
+  BusSession session(*this);
+  _writeCommand(0x11); // set ram entry mode
+  _writeData(entry_mode);
+  _writeCommand(0x44);
+  _writeData(xs);
+  _writeData(xe);
+  _writeCommand(0x45);
+  _writeData(ys % 256);
+  _writeData(ys / 256);
+  _writeData(ye % 256);
+  _writeData(ye / 256);
+  _writeCommand(0x4e);
+  _writeData(xs);
+  _writeCommand(0x4f);
+  _writeData(ys % 256);
+  _writeData(ys / 256);
+}
+
+bool GxEPD2_SSD168x::_startRotatedWrite(uint8_t rotation, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+  // rotation 1 : y first, y increase; rotation 2 : x decrease, y decrease; rotation 3 : y first, y decrease
+  static const uint8_t entry_modes[] = {0x03, 0x07, 0x00, 0x05};
+  if (_initial_write) writeScreenBuffer(); // initial full screen buffer clean
+  delay(1); // yield() to avoid WDT on ESP8266 and ESP32
+  if (!_using_partial_mode) _Init_Part();
+  _setPartialRamArea(x, y, w, h, entry_modes[rotation & 3]);
+  _writeCommand(0x24);
+  return true;
+}
+
+bool GxEPD2_SSD168x::_checkSpiWrite()
+{
+  // write test pattern to RAM at current SPI clock, read back through RAM read
+  static const uint8_t pattern[] = {0x55, 0xAA, 0x00, 0xFF, 0x0F, 0xF0, 0x33, 0xCC};
+  uint8_t data[sizeof(pattern) + 1];
+  if (!_descriptor.ram_read) return false;
+  if (_hibernating) _reset();
+  _initial_write = true; // controller memory is overwritten, next image write starts with a clean buffer
+  _setPartialRamArea(0, 0, sizeof(pattern) * 8, 1);
+  _writeCommand(0x24);
+  _writeData(pattern, sizeof(pattern));
+  _setPartialRamArea(0, 0, sizeof(pattern) * 8, 1);
+  _writeCommand(0x41); // read RAM option
+  _writeData(0x00);    // read RAM 0x24
+  _readController(0x27, data, sizeof(data)); // read RAM, first byte is dummy
+  return memcmp(pattern, data + 1, sizeof(pattern)) == 0;
+}
+
+void GxEPD2_SSD168x::_PowerOn()
+{
+  if (!_power_is_on)
+  {
+    _writeCommand(0x22);
+    _writeData(_descriptor.power_on_control);
+    _writeCommand(0x20);
+    _waitWhileBusy("_PowerOn", _descriptor.power_on_time);
+  }
+  _power_is_on = true;
+}
+
+void GxEPD2_SSD168x::_PowerOff()
+{
+  if (_power_is_on)
+  {
+    _writeCommand(0x22);
+    _writeData(_descriptor.power_off_control);
+    _writeCommand(0x20);
+    _waitWhileBusy("_PowerOff", _descriptor.power_off_time);
+  }
+  _power_is_on = false;
+  _using_partial_mode = false;
+}
+
+void GxEPD2_SSD168x::_InitDisplay()
+{
+  if (_hibernating) _reset();
+  _writeCommandStream(_descriptor.init_display);
+  _setPartialRamArea(0, 0, WIDTH, HEIGHT);
+}
+
+void GxEPD2_SSD168x::_Init_Full()
+{
+  _InitDisplay();
+  if (_descriptor.init_full) _writeCommandStream(_descriptor.init_full);
+  _PowerOn();
+  _using_partial_mode = false;
+}
+
+void GxEPD2_SSD168x::_Init_Part()
+{
+  _InitDisplay();
+  if (_descriptor.init_part) _writeCommandStream(_descriptor.init_part);
+  _PowerOn();
+  _using_partial_mode = true;
+}
+
+void GxEPD2_SSD168x::_Update_Full()
+{
+  _statsRefresh(false);
+  _writeCommand(0x22);
+  _writeData(_descriptor.full_update_control);
+  _writeCommand(0x20);
+  _waitWhileBusy("_Update_Full", _descriptor.full_refresh_time);
+}
+
+void GxEPD2_SSD168x::_Update_Part()
+{
+  _statsRefresh(true);
+  _writeCommand(0x22);
+  _writeData(_descriptor.partial_update_control);
+  _writeCommand(0x20);
+  _waitWhileBusy("_Update_Part", _descriptor.partial_refresh_time);
+}
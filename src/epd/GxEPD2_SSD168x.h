@@ -0,0 +1,100 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// common base of the b/w panels with controllers SSD1680 and SSD1681, e.g. GxEPD2_154_D67, GxEPD2_290_T94,
+// and through GxEPD2_SSD1675 of the panels with controller SSD1675 (IL3897), e.g. GxEPD2_213_B72, GxEPD2_213_B73
+// Controller : SSD1680 : https://www.good-display.com/companyfile/101.html
+// Controller : SSD1681 : http://www.e-paper-display.com/download_detail/downloadsId=825.html
+//
+// a panel driver is a short class with its attributes and a Descriptor of its constant data,
+// all panels of the family share this one copy of the driver code
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#ifndef _GxEPD2_SSD168x_H_
+#define _GxEPD2_SSD168x_H_
+
+#include "../GxEPD2_EPD.h"
+
+class GxEPD2_SSD168x : public GxEPD2_EPD
+{
+  public:
+    // constant data of a panel, defined by the panel driver
+    struct Descriptor
+    {
+      uint16_t width;
+      uint16_t height;
+      GxEPD2::Panel panel;
+      bool hasFastPartialUpdate;
+      uint16_t power_on_time; // ms
+      uint16_t power_off_time; // ms
+      uint16_t full_refresh_time; // ms
+      uint16_t partial_refresh_time; // ms
+      const uint8_t* init_display; // PROGMEM command stream after reset, see GxEPD2_CMD in GxEPD2_EPD.h
+      const uint8_t* init_full; // PROGMEM command stream before power on for full update, e.g. the LUT, or 0
+      const uint8_t* init_part; // PROGMEM command stream before power on for partial update, or 0
+      uint8_t power_on_control; // display update control 2 (0x22) values, run by master activation (0x20)
+      uint8_t power_off_control;
+      uint8_t full_update_control;
+      uint8_t partial_update_control;
+      bool ram_read; // RAM can be read back (0x41, 0x27), for probeSpiFrequency()
+    };
+    // constructor
+    GxEPD2_SSD168x(int8_t cs, int8_t dc, int8_t rst, int8_t busy, const Descriptor& descriptor);
+    // methods (virtual)
+    //  Support for Bitmaps (Sprites) to Controller Buffer and to Screen
+    void clearScreen(uint8_t value = 0xFF); // init controller memory and screen (default white)
+    void writeScreenBuffer(uint8_t value = 0xFF); // init controller memory (default white)
+    void writeScreenBufferAgain(uint8_t value = 0xFF); // init previous buffer controller memory (default white)
+    // write to controller memory, without screen refresh; x and w should be multiple of 8
+    void writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void writeImageForFullRefresh(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                        int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                        int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    // for differential update: set current and previous buffers equal (for fast partial update to work correctly)
+    void writeImageAgain(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void writeImagePartAgain(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                             int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    // write sprite of native data to controller memory, without screen refresh; x and w should be multiple of 8
+    void writeNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    // write to controller memory, with screen refresh; x and w should be multiple of 8
+    void drawImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void drawImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                       int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                       int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    // write sprite of native data to controller memory, with screen refresh; x and w should be multiple of 8
+    void drawNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void refresh(bool partial_update_mode = false); // screen refresh from controller memory to full screen
+    void refresh(int16_t x, int16_t y, int16_t w, int16_t h); // screen refresh from controller memory, partial screen
+    void powerOff(); // turns off generation of panel driving voltages, avoids screen fading over time
+    void hibernate(); // turns powerOff() and sets controller to deep sleep for minimum power use, ONLY if wakeable by RST (rst >= 0)
+  protected:
+    void _setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t entry_mode = 0x03);
+    void _InitDisplay();
+    virtual void _PowerOff();
+    virtual void _Init_Full();
+    virtual void _Init_Part();
+    void _writeScreenBuffer(uint8_t command, uint8_t value);
+    void _writeImage(uint8_t command, const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void _writeImagePart(uint8_t command, const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                         int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+  protected:
+    const Descriptor& _descriptor;
+  private:
+    bool _checkSpiWrite();
+    bool _startRotatedWrite(uint8_t rotation, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    void _PowerOn();
+    void _Update_Full();
+    void _Update_Part();
+};
+
+#endif
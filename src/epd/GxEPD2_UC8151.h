@@ -0,0 +1,91 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: these e-papers require 3.3V supply AND data lines!
+//
+// common base of the b/w panels with controller UC8151 (IL0373) and fast partial update LUTs, e.g. GxEPD2_213_M21, GxEPD2_260_M01, GxEPD2_290_M06,
+// GxEPD2_290_T5, and of the panels with the similar controllers JD79653A (GxEPD2_154_M09) and IL0398 (GxEPD2_420)
+// Controller: UC8151 (IL0373) : https://www.good-display.com/public/html/pdfjs/viewer/viewernew.html?file=https://v4.cecdn.yun300.cn/100001_1909185148/UC8151D.pdf
+// Controller: IL0373 (UC8151) : http://www.e-paper-display.com/download_detail/downloadsId=535.html
+//
+// a panel driver is a short class with its attributes and a Descriptor of its constant data,
+// all panels of the family share this one copy of the driver code
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#ifndef _GxEPD2_UC8151_H_
+#define _GxEPD2_UC8151_H_
+
+#include "../GxEPD2_EPD.h"
+
+class GxEPD2_UC8151 : public GxEPD2_EPD
+{
+  public:
+    // constant data of a panel, defined by the panel driver
+    struct Descriptor
+    {
+      uint16_t width;
+      uint16_t height;
+      GxEPD2::Panel panel;
+      bool hasFastPartialUpdate;
+      uint16_t power_on_time; // ms
+      uint16_t power_off_time; // ms
+      uint16_t full_refresh_time; // ms
+      uint16_t partial_refresh_time; // ms
+      const uint8_t* init_display; // PROGMEM command stream, see GxEPD2_CMD in GxEPD2_EPD.h
+      const uint8_t* init_full; // PROGMEM command stream for full update, e.g. the LUTs, or 0 for the LUTs from OTP
+      const uint8_t* init_part; // PROGMEM command stream for partial update, before the LUTs, or 0
+      uint8_t lut_partial_size; // bytes of each of the lut_partial, 0 if init_part has the LUTs
+      const uint8_t* lut_partial[5]; // PROGMEM LUTs 0x20 vcomDC, 0x21 ww, 0x22 bw, 0x23 wb, 0x24 bb, filled with zeroes
+      bool usePartialUpdateWindow; // refresh(x, y, w, h) within partial in (0x91) and partial out (0x92)
+      bool partial_window_x16; // x of partial window (0x90) as 2 bytes, for IL0398
+    };
+    // constructor
+    GxEPD2_UC8151(int8_t cs, int8_t dc, int8_t rst, int8_t busy, const Descriptor& descriptor);
+    // methods (virtual)
+    //  Support for Bitmaps (Sprites) to Controller Buffer and to Screen
+    void clearScreen(uint8_t value = 0xFF); // init controller memory and screen (default white)
+    void writeScreenBuffer(uint8_t value = 0xFF); // init controller memory (default white)
+    // write to controller memory, without screen refresh; x and w should be multiple of 8
+    void writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                        int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                        int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    // write sprite of native data to controller memory, without screen refresh; x and w should be multiple of 8
+    void writeNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    // write to controller memory, with screen refresh; x and w should be multiple of 8
+    void drawImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void drawImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                       int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                       int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    // write sprite of native data to controller memory, with screen refresh; x and w should be multiple of 8
+    void drawNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void refresh(bool partial_update_mode = false); // screen refresh from controller memory to full screen
+    void refresh(int16_t x, int16_t y, int16_t w, int16_t h); // screen refresh from controller memory, partial screen
+    void powerOff(); // turns off generation of panel driving voltages, avoids screen fading over time
+    void hibernate(); // turns powerOff() and sets controller to deep sleep for minimum power use, ONLY if wakeable by RST (rst >= 0)
+  protected:
+    void _InitDisplay();
+    virtual void _PowerOff();
+    virtual void _Init_Full();
+    virtual void _Init_Part();
+    void _writeScreenBuffer(uint8_t command, uint8_t value);
+    void _writeImage(uint8_t command, const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void _writeImagePart(uint8_t command, const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                         int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void _setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    void _PowerOn();
+    void _Update_Part();
+  protected:
+    const Descriptor& _descriptor;
+  private:
+    void _Update_Full();
+};
+
+#endif
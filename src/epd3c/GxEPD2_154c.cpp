@@ -50,16 +50,17 @@ void GxEPD2_154c::clearScreen(uint8_t black_value, uint8_t color_value)
 {
   _Init_Full();
   _writeCommand(0x10);
+  _startTransfer();
   for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
   {
-    _writeData(bw2grey[(black_value & 0xF0) >> 4]);
-    _writeData(bw2grey[black_value & 0x0F]);
+    _transfer(bw2grey[(black_value & 0xF0) >> 4]);
+    _transfer(bw2grey[black_value & 0x0F]);
   }
+  _endTransfer();
   _writeCommand(0x13);
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _writeData(color_value);
-  }
+  _startTransfer();
+  _transferFill(color_value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
+  _endTransfer();
   _Update_Full();
 }
 
@@ -72,16 +73,17 @@ void GxEPD2_154c::writeScreenBuffer(uint8_t black_value, uint8_t color_value)
 {
   _Init_Full();
   _writeCommand(0x10);
+  _startTransfer();
   for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
   {
-    _writeData(bw2grey[(black_value & 0xF0) >> 4]);
-    _writeData(bw2grey[black_value & 0x0F]);
+    _transfer(bw2grey[(black_value & 0xF0) >> 4]);
+    _transfer(bw2grey[black_value & 0x0F]);
   }
+  _endTransfer();
   _writeCommand(0x13);
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _writeData(color_value);
-  }
+  _startTransfer();
+  _transferFill(color_value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
+  _endTransfer();
 }
 
 void GxEPD2_154c::writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
@@ -134,6 +136,7 @@ void GxEPD2_154c::writeImage(const uint8_t* black, const uint8_t* color, int16_t
     if ((w <= 0) || (h <= 0)) return;
     _Init_Full();
     _writeCommand(0x10);
+    _startTransfer();
     for (int16_t i = 0; i < HEIGHT; i++)
     {
       for (int16_t j = 0; j < WIDTH; j += 8)
@@ -160,11 +163,13 @@ void GxEPD2_154c::writeImage(const uint8_t* black, const uint8_t* color, int16_t
           }
         }
         //_writeData(data);
-        _writeData(bw2grey[(data & 0xF0) >> 4]);
-        _writeData(bw2grey[data & 0x0F]);
+        _transfer(bw2grey[(data & 0xF0) >> 4]);
+        _transfer(bw2grey[data & 0x0F]);
       }
     }
+    _endTransfer();
     _writeCommand(0x13);
+    _startTransfer();
     for (int16_t i = 0; i < HEIGHT; i++)
     {
       for (int16_t j = 0; j < WIDTH; j += 8)
@@ -190,9 +195,10 @@ void GxEPD2_154c::writeImage(const uint8_t* black, const uint8_t* color, int16_t
             if (invert) data = ~data;
           }
         }
-        _writeData(data);
+        _transfer(data);
       }
     }
+    _endTransfer();
   }
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
 }
@@ -227,6 +233,7 @@ void GxEPD2_154c::writeImagePart(const uint8_t* black, const uint8_t* color, int
   if ((w1 <= 0) || (h1 <= 0)) return;
   _Init_Full();
   _writeCommand(0x10);
+  _startTransfer();
   for (int16_t i = 0; i < HEIGHT; i++)
   {
     for (int16_t j = 0; j < WIDTH; j += 8)
@@ -255,11 +262,13 @@ void GxEPD2_154c::writeImagePart(const uint8_t* black, const uint8_t* color, int
         }
       }
       //_writeData(data);
-      _writeData(bw2grey[(data & 0xF0) >> 4]);
-      _writeData(bw2grey[data & 0x0F]);
+      _transfer(bw2grey[(data & 0xF0) >> 4]);
+      _transfer(bw2grey[data & 0x0F]);
     }
   }
+  _endTransfer();
   _writeCommand(0x13);
+  _startTransfer();
   for (int16_t i = 0; i < HEIGHT; i++)
   {
     for (int16_t j = 0; j < WIDTH; j += 8)
@@ -286,9 +295,10 @@ void GxEPD2_154c::writeImagePart(const uint8_t* black, const uint8_t* color, int
           if (invert) data = ~data;
         }
       }
-      _writeData(data);
+      _transfer(data);
     }
   }
+  _endTransfer();
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
 }
 
@@ -465,12 +475,14 @@ void GxEPD2_154c::_Init_Part()
 
 void GxEPD2_154c::_Update_Full()
 {
+  _statsRefresh(false);
   _writeCommand(0x12); //display refresh
   _waitWhileBusy("_Update_Full", full_refresh_time);
 }
 
 void GxEPD2_154c::_Update_Part()
 {
+  _statsRefresh(true);
   _writeCommand(0x12); //display refresh
   _waitWhileBusy("_Update_Part", partial_refresh_time);
 }
@@ -27,15 +27,13 @@ void GxEPD2_270c::clearScreen(uint8_t black_value, uint8_t red_value)
   _initial_write = false; // initial full screen buffer clean done
   _Init_Part();
   _setPartialRamArea_270c(0x14, 0, 0, WIDTH, HEIGHT);
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _writeData(~black_value);
-  }
+  _startTransfer();
+  _transferFill(~black_value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
+  _endTransfer();
   _setPartialRamArea_270c(0x15, 0, 0, WIDTH, HEIGHT);
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _writeData(~red_value);
-  }
+  _startTransfer();
+  _transferFill(~red_value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
+  _endTransfer();
   refresh(0, 0, WIDTH, HEIGHT);
 }
 
@@ -49,15 +47,13 @@ void GxEPD2_270c::writeScreenBuffer(uint8_t black_value, uint8_t color_value)
   _initial_write = false; // initial full screen buffer clean done
   _Init_Part();
   _setPartialRamArea_270c(0x14, 0, 0, WIDTH, HEIGHT);
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _writeData(~black_value);
-  }
+  _startTransfer();
+  _transferFill(~black_value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
+  _endTransfer();
   _setPartialRamArea_270c(0x15, 0, 0, WIDTH, HEIGHT);
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _writeData(~color_value);
-  }
+  _startTransfer();
+  _transferFill(~color_value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
+  _endTransfer();
 }
 
 void GxEPD2_270c::writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
@@ -83,59 +79,15 @@ void GxEPD2_270c::writeImage(const uint8_t* black, const uint8_t* color, int16_t
   if ((w1 <= 0) || (h1 <= 0)) return;
   _Init_Part();
   _setPartialRamArea_270c(0x14, x1, y1, w1, h1);
-  for (int16_t i = 0; i < h1; i++)
-  {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data = 0xFF;
-      if (black)
-      {
-        // use wb, h of bitmap for index!
-        int16_t idx = mirror_y ? j + dx / 8 + ((h - 1 - (i + dy))) * wb : j + dx / 8 + (i + dy) * wb;
-        if (pgm)
-        {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-          data = pgm_read_byte(&black[idx]);
-#else
-          data = black[idx];
-#endif
-        }
-        else
-        {
-          data = black[idx];
-        }
-        if (invert) data = ~data;
-      }
-      _writeData(~data);
-    }
-  }
+  _startTransfer();
+  if (black) _transferRows(black, wb, h, dx / 8, dy, w1 / 8, h1, !invert, mirror_y, pgm);
+  else _transferFill(0x00, uint32_t(w1 / 8) * h1);
+  _endTransfer();
   _setPartialRamArea_270c(0x15, x1, y1, w1, h1);
-  for (int16_t i = 0; i < h1; i++)
-  {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data = 0xFF;
-      if (color)
-      {
-        // use wb, h of bitmap for index!
-        int16_t idx = mirror_y ? j + dx / 8 + ((h - 1 - (i + dy))) * wb : j + dx / 8 + (i + dy) * wb;
-        if (pgm)
-        {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-          data = pgm_read_byte(&color[idx]);
-#else
-          data = color[idx];
-#endif
-        }
-        else
-        {
-          data = color[idx];
-        }
-        if (invert) data = ~data;
-      }
-      _writeData(~data);
-    }
-  }
+  _startTransfer();
+  if (color) _transferRows(color, wb, h, dx / 8, dy, w1 / 8, h1, !invert, mirror_y, pgm);
+  else _transferFill(0x00, uint32_t(w1 / 8) * h1);
+  _endTransfer();
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
 }
 
@@ -170,56 +122,14 @@ void GxEPD2_270c::writeImagePart(const uint8_t* black, const uint8_t* color, int
   if ((w1 <= 0) || (h1 <= 0)) return;
   if (!_using_partial_mode) _Init_Part();
   _setPartialRamArea_270c(0x14, x1, y1, w1, h1);
-  for (int16_t i = 0; i < h1; i++)
-  {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data;
-      // use wb_bitmap, h_bitmap of bitmap for index!
-      int16_t idx = mirror_y ? x_part / 8 + j + dx / 8 + ((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + (y_part + i + dy) * wb_bitmap;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&black[idx]);
-#else
-        data = black[idx];
-#endif
-      }
-      else
-      {
-        data = black[idx];
-      }
-      if (invert) data = ~data;
-      _writeData(~data);
-    }
-  }
+  _startTransfer();
+  _transferRows(black, wb_bitmap, h_bitmap, x_part / 8 + dx / 8, y_part + dy, w1 / 8, h1, !invert, mirror_y, pgm);
+  _endTransfer();
   _setPartialRamArea_270c(0x15, x1, y1, w1, h1);
-  for (int16_t i = 0; i < h1; i++)
-  {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data = 0xFF;
-      if (color)
-      {
-        // use wb_bitmap, h_bitmap of bitmap for index!
-        int16_t idx = mirror_y ? x_part / 8 + j + dx / 8 + ((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + (y_part + i + dy) * wb_bitmap;
-        if (pgm)
-        {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-          data = pgm_read_byte(&color[idx]);
-#else
-          data = color[idx];
-#endif
-        }
-        else
-        {
-          data = color[idx];
-        }
-        if (invert) data = ~data;
-      }
-      _writeData(~data);
-    }
-  }
+  _startTransfer();
+  if (color) _transferRows(color, wb_bitmap, h_bitmap, x_part / 8 + dx / 8, y_part + dy, w1 / 8, h1, !invert, mirror_y, pgm);
+  else _transferFill(0x00, uint32_t(w1 / 8) * h1);
+  _endTransfer();
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
 }
 
@@ -312,6 +222,7 @@ void GxEPD2_270c::hibernate()
 
 void GxEPD2_270c::_setPartialRamArea_270c(uint8_t cmd, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
 {
+  BusSession session(*this);
   w = (w + 7 + (x % 8)) & 0xfff8; // byte boundary exclusive (round up)
   _writeCommand(cmd);
   _writeData(x >> 8);
@@ -474,12 +385,14 @@ void GxEPD2_270c::_Init_Part()
 
 void GxEPD2_270c::_Update_Full()
 {
+  _statsRefresh(false);
   _writeCommand(0x12); //display refresh
   _waitWhileBusy("_Update_Full", full_refresh_time);
 }
 
 void GxEPD2_270c::_Update_Part()
 {
+  _statsRefresh(true);
   _writeCommand(0x12); //display refresh
   _waitWhileBusy("_Update_Part", partial_refresh_time);
 }
@@ -42,11 +42,7 @@ void GxEPD2_565c::writeScreenBuffer(uint8_t black_value, uint8_t color_value)
   _Init_Full();
   _writeCommand(0x10);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 2; i++)
-  {
-    //_transfer(0x11);
-    _transfer(0xFF == black_value ? 0x11 : black_value);
-  }
+  _transferFill(0xFF == black_value ? 0x11 : black_value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 2);
   _endTransfer();
 }
 
@@ -621,12 +617,14 @@ void GxEPD2_565c::_Init_Part()
 
 void GxEPD2_565c::_Update_Full()
 {
+  _statsRefresh(false);
   _writeCommand(0x12); // Display Refresh
   _waitWhileBusy("_Update_Full", full_refresh_time);
 }
 
 void GxEPD2_565c::_Update_Part()
 {
+  _statsRefresh(true);
   _writeCommand(0x12); // Display Refresh
   _waitWhileBusy("_Update_Part", partial_refresh_time);
 }
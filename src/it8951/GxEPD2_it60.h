@@ -69,6 +69,7 @@ class GxEPD2_it60 : public GxEPD2_EPD
     void refresh(int16_t x, int16_t y, int16_t w, int16_t h); // screen refresh from controller memory, partial screen
     void powerOff(); // turns off generation of panel driving voltages, avoids screen fading over time
     void hibernate(); // turns powerOff() and sets controller to deep sleep for minimum power use, ONLY if wakeable by RST (rst >= 0)
+    void setSpiFrequency(uint32_t frequency); // SPI clock for writes, default 24MHz, reads use 1MHz
   private:
     struct IT8951DevInfoStruct
     {
@@ -60,6 +60,7 @@ GxEPD2_it60_1448x1072::GxEPD2_it60_1448x1072(int8_t cs, int8_t dc, int8_t rst, i
   _spi_settings(24000000, MSBFIRST, SPI_MODE0),
   _spi_settings_for_read(1000000, MSBFIRST, SPI_MODE0)
 {
+  _spi_frequency = 24000000;
 }
 
 void GxEPD2_it60_1448x1072::init(uint32_t serial_diag_bitrate)
@@ -112,19 +113,19 @@ void GxEPD2_it60_1448x1072::clearScreen(uint8_t value)
   else _Init_Part();
   _initial_refresh = false;
   _setPartialRamArea(0, 0, WIDTH, HEIGHT);
-  SPI.beginTransaction(_spi_settings);
+  _bus->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
   _transfer16(0x0000); // preamble for write data
   _waitWhileBusy2("clearScreen preamble", default_wait_time);
   for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT); i++)
   {
-    SPI.transfer(value);
+    _bus->transfer(value);
 #if defined(ESP8266) || defined(ESP32)
     if (0 == i % 10000) yield();
 #endif
   }
   if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _bus->endTransaction();
   _writeCommand16(IT8951_TCON_LD_IMG_END);
   _waitWhileBusy2("clearScreen load end", default_wait_time);
   _refresh(0, 0, WIDTH, HEIGHT, false);
@@ -141,19 +142,19 @@ void GxEPD2_it60_1448x1072::_writeScreenBuffer(uint8_t value)
   _initial_write = false; // initial full screen buffer clean done
   if (!_using_partial_mode) _Init_Part();
   _setPartialRamArea(0, 0, WIDTH, HEIGHT);
-  SPI.beginTransaction(_spi_settings);
+  _bus->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
   _transfer16(0x0000); // preamble for write data
   _waitWhileBusy2("clearScreen preamble", default_wait_time);
   for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT); i++)
   {
-    SPI.transfer(value);
+    _bus->transfer(value);
 #if defined(ESP8266) || defined(ESP32)
     if (0 == i % 10000) yield();
 #endif
   }
   if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _bus->endTransaction();
   _writeCommand16(IT8951_TCON_LD_IMG_END);
   _waitWhileBusy2("_writeScreenBuffer load end", default_wait_time);
 }
@@ -176,7 +177,7 @@ void GxEPD2_it60_1448x1072::writeImage(const uint8_t bitmap[], int16_t x, int16_
   if ((w1 <= 0) || (h1 <= 0)) return;
   if (!_using_partial_mode) _Init_Part();
   _setPartialRamArea(x1, y1, w1, h1);
-  SPI.beginTransaction(_spi_settings);
+  _bus->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
   _transfer16(0x0000); // preamble for write data
   _waitWhileBusy2("writeImage preamble", default_wait_time);
@@ -207,7 +208,7 @@ void GxEPD2_it60_1448x1072::writeImage(const uint8_t bitmap[], int16_t x, int16_
 #endif
   }
   if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _bus->endTransaction();
   _writeCommand16(IT8951_TCON_LD_IMG_END);
   _waitWhileBusy2("writeImage load end", default_wait_time);
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
@@ -238,7 +239,7 @@ void GxEPD2_it60_1448x1072::writeImagePart(const uint8_t bitmap[], int16_t x_par
   if ((w1 <= 0) || (h1 <= 0)) return;
   if (!_using_partial_mode) _Init_Part();
   _setPartialRamArea(x1, y1, w1, h1);
-  SPI.beginTransaction(_spi_settings);
+  _bus->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
   _transfer16(0x0000); // preamble for write data
   _waitWhileBusy2("writeImage preamble", default_wait_time);
@@ -266,7 +267,7 @@ void GxEPD2_it60_1448x1072::writeImagePart(const uint8_t bitmap[], int16_t x_par
     }
   }
   if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _bus->endTransaction();
   _writeCommand16(IT8951_TCON_LD_IMG_END);
   _waitWhileBusy2("writeImage load end", default_wait_time);
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
@@ -306,7 +307,7 @@ void GxEPD2_it60_1448x1072::writeNative(const uint8_t* data1, const uint8_t* dat
     if ((w1 <= 0) || (h1 <= 0)) return;
     if (!_using_partial_mode) _Init_Part();
     _setPartialRamArea(x1, y1, w1, h1);
-    SPI.beginTransaction(_spi_settings);
+    _bus->beginTransaction(_spi_settings);
     if (_cs >= 0) digitalWrite(_cs, LOW);
     _transfer16(0x0000); // preamble for write data
     _waitWhileBusy2("writeNative preamble", default_wait_time);
@@ -330,14 +331,14 @@ void GxEPD2_it60_1448x1072::writeNative(const uint8_t* data1, const uint8_t* dat
           data = data1[idx];
         }
         if (invert) data = ~data;
-        SPI.transfer(data);
+        _bus->transfer(data);
       }
 #if defined(ESP8266) || defined(ESP32)
       yield();
 #endif
     }
     if (_cs >= 0) digitalWrite(_cs, HIGH);
-    SPI.endTransaction();
+    _bus->endTransaction();
     _writeCommand16(IT8951_TCON_LD_IMG_END);
     _waitWhileBusy2("writeNative load end", default_wait_time);
     delay(1); // yield() to avoid WDT on ESP8266 and ESP32
@@ -409,6 +410,7 @@ void GxEPD2_it60_1448x1072::_refresh(int16_t x, int16_t y, int16_t w, int16_t h,
   _writeData16(h1);
   _waitWhileBusy2("refresh h", refresh_par_time);
   _writeData16(partial_update_mode ? 1 : 2); // mode
+  _statsRefresh(partial_update_mode);
   _waitWhileBusy("refresh", full_refresh_time);
 }
 
@@ -430,11 +432,17 @@ void GxEPD2_it60_1448x1072::hibernate()
   }
 }
 
+void GxEPD2_it60_1448x1072::setSpiFrequency(uint32_t frequency)
+{
+  GxEPD2_EPD::setSpiFrequency(frequency);
+  _spi_settings = SPISettings(frequency, MSBFIRST, SPI_MODE0);
+}
+
 void GxEPD2_it60_1448x1072::_send8pixel(uint8_t data)
 {
   for (uint8_t j = 0; j < 8; j++)
   {
-    SPI.transfer(data & 0x80 ? 0x00 : 0xFF);
+    _bus->transfer(data & 0x80 ? 0x00 : 0xFF);
     data <<= 1;
   }
 }
@@ -534,40 +542,40 @@ void GxEPD2_it60_1448x1072::_waitWhileBusy2(const char* comment, uint16_t busy_t
 
 uint16_t GxEPD2_it60_1448x1072::_transfer16(uint16_t value)
 {
-  uint16_t rv = SPI.transfer(value >> 8) << 8;
-  return (rv | SPI.transfer(value));
+  uint16_t rv = _bus->transfer(value >> 8) << 8;
+  return (rv | _bus->transfer(value));
 }
 
 void GxEPD2_it60_1448x1072::_writeCommand16(uint16_t c)
 {
   String s = String("_writeCommand16(0x") + String(c, HEX) + String(")");
   _waitWhileBusy2(s.c_str(), default_wait_time);
-  SPI.beginTransaction(_spi_settings);
+  _bus->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
   _transfer16(0x6000); // preamble for write command
   _waitWhileBusy2("_writeCommand16 preamble", default_wait_time);
   _transfer16(c);
   if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _bus->endTransaction();
   //_waitWhileBusy(s.c_str(), default_wait_time);
 }
 
 void GxEPD2_it60_1448x1072::_writeData16(uint16_t d)
 {
   _waitWhileBusy2("_writeData16", default_wait_time);
-  SPI.beginTransaction(_spi_settings);
+  _bus->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
   _transfer16(0x0000); // preamble for write data
   _waitWhileBusy2("_writeData16 preamble", default_wait_time);
   _transfer16(d);
   if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _bus->endTransaction();
 }
 
 void GxEPD2_it60_1448x1072::_writeData16(const uint16_t* d, uint32_t n)
 {
   _waitWhileBusy2("_writeData16", default_wait_time);
-  SPI.beginTransaction(_spi_settings);
+  _bus->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
   _transfer16(0x0000); // preamble for write data
   _waitWhileBusy2("_writeData16 preamble", default_wait_time);
@@ -576,13 +584,13 @@ void GxEPD2_it60_1448x1072::_writeData16(const uint16_t* d, uint32_t n)
     _transfer16(*d++);
   }
   if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _bus->endTransaction();
 }
 
 uint16_t GxEPD2_it60_1448x1072::_readData16()
 {
   _waitWhileBusy2("_readData16", default_wait_time);
-  SPI.beginTransaction(_spi_settings);
+  _bus->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
   _transfer16(0x1000); // preamble for read data
   _waitWhileBusy2("_readData16 preamble", default_wait_time);
@@ -590,14 +598,14 @@ uint16_t GxEPD2_it60_1448x1072::_readData16()
   _waitWhileBusy2("_readData16 dummy", default_wait_time);
   uint16_t rv = _transfer16(0);
   if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _bus->endTransaction();
   return rv;
 }
 
 void GxEPD2_it60_1448x1072::_readData16(uint16_t* d, uint32_t n)
 {
   _waitWhileBusy2("_readData16", default_wait_time);
-  SPI.beginTransaction(_spi_settings);
+  _bus->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
   _transfer16(0x1000); // preamble for read data
   _waitWhileBusy2("_readData16 preamble", default_wait_time);
@@ -609,7 +617,7 @@ void GxEPD2_it60_1448x1072::_readData16(uint16_t* d, uint32_t n)
     //_waitWhileBusy("_readData16 data", default_wait_time);
   }
   if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _bus->endTransaction();
 }
 
 void GxEPD2_it60_1448x1072::_writeCommandData16(uint16_t c, const uint16_t* d, uint16_t n)